@@ -0,0 +1,42 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Alocação linear sobre um buffer estático: arena_alloc() só avança um
+// índice (sem heap, sem fragmentação) e arena_reset() devolve tudo de uma
+// vez, zerando o que foi usado. O dono do buffer decide o tamanho em tempo
+// de compilação.
+#define ARENA_ALIGN 8
+
+typedef struct {
+    uint8_t *base;     // alinhado a ARENA_ALIGN
+    size_t size;
+    size_t used;
+    size_t peak;       // maior uso desde arena_init(), para dimensionar
+} Arena;
+
+static inline void arena_init(Arena *arena, void *buffer, size_t size) {
+    arena->base = buffer;
+    arena->size = size;
+    arena->used = 0;
+    arena->peak = 0;
+}
+
+// NULL se não couber
+static inline void *arena_alloc(Arena *arena, size_t size) {
+    size_t start = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (start > arena->size || size > arena->size - start) return NULL;
+    arena->used = start + size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return arena->base + start;
+}
+
+static inline void arena_reset(Arena *arena) {
+    memset(arena->base, 0, arena->used);
+    arena->used = 0;
+}
+
+#endif // ARENA_H
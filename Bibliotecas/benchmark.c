@@ -0,0 +1,427 @@
+#include "benchmark.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <esp_cpu.h>
+#include <esp_log.h>
+#include <sdkconfig.h>
+
+#include "display.h"
+#include "font5x7.h"
+#include "mpu6050.h"
+#include "rng.h"
+#include "sensor.h"
+
+static const char *TAG = "benchmark";
+
+static inline uint32_t cycles_now() {
+    return esp_cpu_get_cycle_count();
+}
+
+static inline uint64_t cycles_to_ns(uint64_t cycles) {
+    return cycles * 1000 / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+}
+
+// Custo de ler o contador duas vezes, descontado de cada medição
+static uint32_t timer_overhead() {
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < 64; i++) {
+        uint32_t t0 = cycles_now();
+        uint32_t t1 = cycles_now();
+        if (t1 - t0 < best) best = t1 - t0;
+    }
+    return best;
+}
+
+// Ângulos (rad) da inclinação sintética: suave nos dois eixos com períodos
+// diferentes, passando pelo limiar várias vezes
+static void synthetic_angles(float t, float *angle_x, float *angle_y) {
+    *angle_x = 0.64f * sinf(t * 0.05f);
+    *angle_y = 0.64f * cosf(t * 0.037f);
+}
+
+// Acelerômetro parado na inclinação dada, mais ruído de tremida
+static void angles_to_accel(float angle_x, float angle_y, int16_t accel[3]) {
+    float ax = sinf(angle_x) + ((rand() % 21) - 10) * 0.005f;
+    float ay = sinf(angle_y) + ((rand() % 21) - 10) * 0.005f;
+    float az2 = 1.0f - sinf(angle_x) * sinf(angle_x) - sinf(angle_y) * sinf(angle_y);
+    accel[0] = (int16_t)(16384 * ax);
+    accel[1] = (int16_t)(16384 * ay);
+    accel[2] = (int16_t)(16384 * sqrtf(az2 > 0 ? az2 : 0));
+}
+
+void benchmark_synthetic_input(int tick, int16_t accel[3]) {
+    float angle_x, angle_y;
+    synthetic_angles(tick, &angle_x, &angle_y);
+    angles_to_accel(angle_x, angle_y, accel);
+}
+
+typedef struct {
+    uint32_t overhead;
+    uint64_t update_cycles, draw_cycles, bytes;
+    uint32_t worst_cycles;
+} BenchTotals;
+
+static void bench_begin(BenchTotals *totals, const Game *game, BenchResult *result) {
+    memset(totals, 0, sizeof(*totals));
+    totals->overhead = timer_overhead();
+    memset(result, 0, sizeof(*result));
+    result->name = game->name;
+
+    clear_screen();
+    display_invalidate();
+    display_measure_flush();
+}
+
+static void bench_tick(BenchTotals *totals, const Game *game, void *state,
+                       const TiltInput *tilt, BenchResult *result) {
+    uint32_t t0 = cycles_now();
+    game->input(state, tilt);
+    game->update(state);
+    // Sem as pausas do game_task: a próxima fase já começa no mesmo tick
+    if (game_level_complete(game, state)) {
+        game->next_level(state);
+    }
+    uint32_t t1 = cycles_now();
+    game->draw(state);
+    uint32_t t2 = cycles_now();
+
+    uint32_t update = (t1 - t0) > totals->overhead ? (t1 - t0) - totals->overhead : 0;
+    uint32_t draw = (t2 - t1) > totals->overhead ? (t2 - t1) - totals->overhead : 0;
+    totals->update_cycles += update;
+    totals->draw_cycles += draw;
+    totals->bytes += display_measure_flush();
+    if (update + draw > totals->worst_cycles) {
+        totals->worst_cycles = update + draw;
+        result->worst_tick = result->ticks;
+    }
+    result->ticks++;
+}
+
+static void bench_end(const BenchTotals *totals, BenchResult *result) {
+    if (result->ticks == 0) return;
+    result->update_ns = (uint32_t)(cycles_to_ns(totals->update_cycles) / result->ticks);
+    result->draw_ns = (uint32_t)(cycles_to_ns(totals->draw_cycles) / result->ticks);
+    result->flush_bytes = (uint32_t)(totals->bytes / result->ticks);
+    result->worst_ns = (uint32_t)cycles_to_ns(totals->worst_cycles);
+}
+
+void benchmark_run(const Game *game, int ticks, BenchInputFn input, BenchResult *result) {
+    void *state = malloc(game->state_size);
+    TiltPipeline pipeline;
+    BenchTotals totals;
+
+    bench_begin(&totals, game, result);
+    srand(1); // ruído da entrada sintética
+    tilt_pipeline_init(&pipeline, TILT_ALPHA_FRAME, 0);
+    game->init(state, BENCHMARK_SEED);
+
+    for (int t = 0; t < ticks; t++) {
+        if (game->game_over(state)) {
+            result->restarts++;
+            game->init(state, BENCHMARK_SEED + result->restarts);
+        }
+
+        int16_t accel[3];
+        TiltInput tilt;
+        input(t, accel);
+        tilt_pipeline_push(&pipeline, accel, NULL);
+        tilt_pipeline_output(&pipeline, &tilt);
+        bench_tick(&totals, game, state, &tilt, result);
+    }
+
+    bench_end(&totals, result);
+    free(state);
+}
+
+bool benchmark_replay(const Game *game, ReplayReader *replay, BenchResult *result) {
+    void *state = malloc(game->state_size);
+    BenchTotals totals;
+    TiltInput tilt;
+
+    bench_begin(&totals, game, result);
+    game->init(state, replay->header.seed);
+
+    while (!game->game_over(state) && replay_reader_next(replay, &tilt)) {
+        bench_tick(&totals, game, state, &tilt, result);
+    }
+    bench_end(&totals, result);
+
+    // Gravação interrompida (ticks = 0 no cabeçalho): não há o que conferir
+    if (replay->header.ticks == 0) {
+        free(state);
+        return true;
+    }
+    bool exact = result->ticks == replay->header.ticks &&
+                 game->score(state) == replay->header.final_score;
+    if (!exact) {
+        ESP_LOGE(TAG, "%s: repetição divergiu (tick %u de %u, pontuação %d, gravada %d)",
+                 game->name, (unsigned)result->ticks, (unsigned)replay->header.ticks,
+                 game->score(state), (int)replay->header.final_score);
+    }
+    free(state);
+    return exact;
+}
+
+void benchmark_report(const BenchResult *results, int count) {
+    ESP_LOGI(TAG, "%-10s %7s %9s %9s %9s %8s %9s %7s", "jogo", "ticks", "update ns", "draw ns",
+             "bytes/q", "reinic.", "pior ns", "no tick");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        ESP_LOGI(TAG, "%-10s %7u %9u %9u %9u %8u %9u %7u", r->name, (unsigned)r->ticks,
+                 (unsigned)r->update_ns, (unsigned)r->draw_ns,
+                 (unsigned)r->flush_bytes, (unsigned)r->restarts,
+                 (unsigned)r->worst_ns, (unsigned)r->worst_tick);
+    }
+}
+
+// Caminho antigo, como estava em cada loop de jogo
+static void float_direction(float ax, float ay, int *dx, int *dy) {
+    *dx = 0;
+    *dy = 0;
+    if (fabsf(ax) > 0.3f || fabsf(ay) > 0.3f) {
+        if (fabsf(ax) > fabsf(ay)) {
+            *dx = (ax > 0) ? 1 : -1;
+        } else {
+            *dy = (ay > 0) ? 1 : -1;
+        }
+    }
+}
+
+static float g_to_degrees(float g) {
+    if (g > 1.0f) g = 1.0f;
+    if (g < -1.0f) g = -1.0f;
+    return asinf(g) * (180.0f / (float)M_PI);
+}
+
+void benchmark_tilt_pipeline(int samples) {
+    const float rate = SENSOR_SAMPLE_RATE_HZ;
+    const float rad_to_gyro = (180.0f / (float)M_PI) * TILT_GYRO_LSB_PER_DPS;
+    int16_t (*accel)[3] = malloc(samples * sizeof(*accel));
+    int16_t (*gyro)[3] = malloc(samples * sizeof(*gyro));
+    float (*truth)[2] = malloc(samples * sizeof(*truth));
+    float (*float_out)[2] = malloc(samples * sizeof(*float_out));
+    TiltInput *fused_out = malloc(samples * sizeof(*fused_out));
+    uint32_t overhead = timer_overhead();
+    const float alpha = TILT_ALPHA_FIFO / (float)Q15_ONE;
+    float fx = 0, fy = 0;
+    TiltPipeline p;
+
+    // Mesma curva do jogo, amostrada a 200 Hz (4 amostras por tick de 50 ms)
+    srand(1);
+    for (int i = 0; i < samples; i++) {
+        float t = i / (rate * 0.05f);
+        float angle_x, angle_y, next_x, next_y;
+        synthetic_angles(t, &angle_x, &angle_y);
+        synthetic_angles(t + 1.0f / (rate * 0.05f), &next_x, &next_y);
+        angles_to_accel(angle_x, angle_y, accel[i]);
+
+        // Giroscópio: variação do ângulo até a próxima amostra, com ruído
+        gyro[i][0] = (int16_t)((next_y - angle_y) * rate * rad_to_gyro) + (rand() % 41) - 20;
+        gyro[i][1] = (int16_t)(-(next_x - angle_x) * rate * rad_to_gyro) + (rand() % 41) - 20;
+        gyro[i][2] = (rand() % 41) - 20;
+        truth[i][0] = angle_x * (180.0f / (float)M_PI);
+        truth[i][1] = angle_y * (180.0f / (float)M_PI);
+    }
+
+    // Float: uma amostra por vez, como o jogo fazia
+    uint32_t t0 = cycles_now();
+    for (int i = 0; i < samples; i++) {
+        fx = low_pass_filter(accel[i][0] / 16384.0, fx, alpha);
+        fy = low_pass_filter(accel[i][1] / 16384.0, fy, alpha);
+        float_out[i][0] = fx;
+        float_out[i][1] = fy;
+    }
+    uint32_t float_cycles = cycles_now() - t0 - overhead;
+
+    // Fusão com o giroscópio, direções com histerese
+    tilt_pipeline_init(&p, TILT_ALPHA_FIFO, SENSOR_SAMPLE_RATE_HZ);
+    t0 = cycles_now();
+    for (int i = 0; i < samples; i++) {
+        tilt_pipeline_push(&p, accel[i], gyro[i]);
+        tilt_pipeline_output(&p, &fused_out[i]);
+    }
+    uint32_t fused_cycles = cycles_now() - t0 - overhead;
+
+    // Erro em graus e decisões contra o ângulo real (limiar de 0.3 g)
+    double float_err = 0, fused_err = 0;
+    int float_wrong = 0, fused_wrong = 0;
+    for (int i = 0; i < samples; i++) {
+        int tx, ty, dx, dy;
+        float_direction(sinf(truth[i][0] * ((float)M_PI / 180.0f)),
+                        sinf(truth[i][1] * ((float)M_PI / 180.0f)), &tx, &ty);
+
+        float_direction(float_out[i][0], float_out[i][1], &dx, &dy);
+        float_wrong += (dx != tx || dy != ty);
+        float_err += fabsf(g_to_degrees(float_out[i][0]) - truth[i][0]) +
+                     fabsf(g_to_degrees(float_out[i][1]) - truth[i][1]);
+
+        fused_wrong += (fused_out[i].dir_x != tx || fused_out[i].dir_y != ty);
+        fused_err += fabsf(fused_out[i].x * 90.0f / Q15_ONE - truth[i][0]) +
+                     fabsf(fused_out[i].y * 90.0f / Q15_ONE - truth[i][1]);
+    }
+
+    ESP_LOGI(TAG, "pipeline de inclinação, %d amostras:", samples);
+    ESP_LOGI(TAG, "  float:  %5.1f ciclos/amostra, erro médio %4.1f graus, %d decisões erradas",
+             (double)float_cycles / samples, float_err / (2 * samples), float_wrong);
+    ESP_LOGI(TAG, "  fusão:  %5.1f ciclos/amostra, erro médio %4.1f graus, %d decisões erradas",
+             (double)fused_cycles / samples, fused_err / (2 * samples), fused_wrong);
+
+    free(accel);
+    free(gyro);
+    free(truth);
+    free(float_out);
+    free(fused_out);
+}
+
+// Maior desvio (%) de um balde em relação à contagem esperada
+static double worst_bucket(const uint32_t *buckets, int count, int samples) {
+    double expected = (double)samples / count, worst = 0;
+    for (int i = 0; i < count; i++) {
+        double dev = fabs(buckets[i] - expected) / expected;
+        if (dev > worst) worst = dev;
+    }
+    return worst * 100;
+}
+
+void benchmark_rng(int samples) {
+    const uint32_t bound = WIDTH - 10; // posição x dos blocos do Dodge
+    uint32_t *buckets = calloc(bound, sizeof(*buckets));
+    uint32_t overhead = timer_overhead();
+    uint32_t sum = 0;
+    Rng rng;
+
+    srand(1);
+    uint32_t t0 = cycles_now();
+    for (int i = 0; i < samples; i++) {
+        sum += rand() % bound;
+    }
+    uint32_t libc_cycles = cycles_now() - t0 - overhead;
+
+    rng_seed(&rng, 1);
+    t0 = cycles_now();
+    for (int i = 0; i < samples; i++) {
+        sum += rng_below(&rng, bound);
+    }
+    uint32_t rng_cycles = cycles_now() - t0 - overhead;
+
+    // Distribuição, fora da medição
+    srand(1);
+    for (int i = 0; i < samples; i++) buckets[rand() % bound]++;
+    double libc_dev = worst_bucket(buckets, bound, samples);
+    memset(buckets, 0, bound * sizeof(*buckets));
+    rng_seed(&rng, 1);
+    for (int i = 0; i < samples; i++) buckets[rng_below(&rng, bound)]++;
+    double rng_dev = worst_bucket(buckets, bound, samples);
+
+    ESP_LOGI(TAG, "sorteio em [0, %u), %d números (soma %u):", (unsigned)bound, samples,
+             (unsigned)sum);
+    ESP_LOGI(TAG, "  rand():  %5.1f ciclos/número, maior desvio de um valor %4.1f%%",
+             (double)libc_cycles / samples, libc_dev);
+    ESP_LOGI(TAG, "  rng.h:   %5.1f ciclos/número, maior desvio de um valor %4.1f%%",
+             (double)rng_cycles / samples, rng_dev);
+    free(buckets);
+}
+
+// Caminho antigo das primitivas, como estava em display.c
+static void pixel_rect(int x, int y, int width, int height, bool fill) {
+    for (int i = x; i < x + width; i++) {
+        for (int j = y; j < y + height; j++) {
+            if (fill || i == x || i == x + width - 1 || j == y || j == y + height - 1) {
+                draw_pixel(i, j, true);
+            }
+        }
+    }
+}
+
+static void pixel_text(int x, int y, const char *text) {
+    for (; *text; text++, x += FONT5X7_WIDTH + 1) {
+        if (*text < 32 || *text > 126) continue;
+        const uint8_t *glyph = font5x7_basic[*text - 32];
+        for (int i = 0; i < FONT5X7_WIDTH; i++) {
+            for (int j = 0; j < FONT5X7_HEIGHT; j++) {
+                if (glyph[i] & (1 << j)) draw_pixel(x + i, y + j, true);
+            }
+        }
+    }
+}
+
+// Posições que percorrem a tela e saem um pouco pelas bordas
+static inline int draw_x(int i) { return (i * 37) % (WIDTH + 16) - 8; }
+static inline int draw_y(int i) { return (i * 13) % (HEIGHT + 16) - 8; }
+
+static void fast_food(int i) { draw_rect(draw_x(i), draw_y(i), 8, 8, false); }
+static void slow_food(int i) { pixel_rect(draw_x(i), draw_y(i), 8, 8, false); }
+static void fast_paddle(int i) { draw_rect(draw_x(i), draw_y(i), 20, 2, true); }
+static void slow_paddle(int i) { pixel_rect(draw_x(i), draw_y(i), 20, 2, true); }
+static void fast_wall(int i) { draw_rect(draw_x(i), draw_y(i), 4, 4, true); }
+static void slow_wall(int i) { pixel_rect(draw_x(i), draw_y(i), 4, 4, true); }
+static void fast_block(int i) { draw_rect(draw_x(i), draw_y(i), 40, 24, true); }
+static void slow_block(int i) { pixel_rect(draw_x(i), draw_y(i), 40, 24, true); }
+static void fast_text(int i) { draw_text(draw_x(i), draw_y(i), "Score: 123"); }
+static void slow_text(int i) { pixel_text(draw_x(i), draw_y(i), "Score: 123"); }
+
+typedef struct {
+    const char *name;
+    void (*fast)(int i);
+    void (*slow)(int i);
+} DrawCase;
+
+static const DrawCase draw_cases[] = {
+    { "comida 8x8", fast_food, slow_food },
+    { "raquete 20x2", fast_paddle, slow_paddle },
+    { "parede 4x4", fast_wall, slow_wall },
+    { "bloco 40x24", fast_block, slow_block },
+    { "texto 10 car.", fast_text, slow_text },
+};
+
+static uint32_t time_draw(void (*draw)(int i), int calls, uint32_t overhead) {
+    clear_screen();
+    uint32_t t0 = cycles_now();
+    for (int i = 0; i < calls; i++) draw(i);
+    uint32_t cycles = cycles_now() - t0 - overhead;
+    return (uint32_t)(cycles_to_ns(cycles) / calls);
+}
+
+void benchmark_draw(int calls) {
+    static uint8_t expected[BUFFER_SIZE];
+    uint32_t overhead = timer_overhead();
+
+    ESP_LOGI(TAG, "%-14s %10s %10s %s", "primitiva", "pixel ns", "faixa ns", "buffer");
+    for (size_t c = 0; c < sizeof(draw_cases) / sizeof(draw_cases[0]); c++) {
+        const DrawCase *dc = &draw_cases[c];
+        uint32_t slow_ns = time_draw(dc->slow, calls, overhead);
+        uint32_t fast_ns = time_draw(dc->fast, calls, overhead);
+
+        // Confere chamada a chamada, fora da medição
+        int mismatches = 0;
+        for (int i = 0; i < calls; i++) {
+            clear_screen();
+            dc->slow(i);
+            memcpy(expected, display_buffer, BUFFER_SIZE);
+            clear_screen();
+            dc->fast(i);
+            mismatches += memcmp(expected, display_buffer, BUFFER_SIZE) != 0;
+        }
+        ESP_LOGI(TAG, "%-14s %10u %10u %s", dc->name, (unsigned)slow_ns, (unsigned)fast_ns,
+                 mismatches ? "DIFERENTE" : "igual");
+    }
+
+    // Limpeza depois de um HUD típico: a tela inteira contra só as faixas com tinta
+    uint64_t full_cycles = 0, ink_cycles = 0;
+    for (int i = 0; i < calls; i++) {
+        fast_text(i);
+        uint32_t t0 = cycles_now();
+        memset(display_buffer, 0, BUFFER_SIZE);
+        full_cycles += cycles_now() - t0 - overhead;
+
+        fast_text(i);
+        t0 = cycles_now();
+        clear_screen();
+        ink_cycles += cycles_now() - t0 - overhead;
+    }
+    ESP_LOGI(TAG, "%-14s %10u %10u", "limpar HUD", (unsigned)(cycles_to_ns(full_cycles) / calls),
+             (unsigned)(cycles_to_ns(ink_cycles) / calls));
+    clear_screen();
+}
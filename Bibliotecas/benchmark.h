@@ -0,0 +1,64 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+#include "replay.h"
+#include "tilt.h"
+
+// Firmware especial: com -DBENCHMARK_MODE=1 o app_main roda os benchmarks
+// dos jogos e mostra o resultado no log em vez de abrir o menu
+#ifndef BENCHMARK_MODE
+#define BENCHMARK_MODE 0
+#endif
+
+#define BENCHMARK_TICKS 5000
+#define BENCHMARK_TILT_SAMPLES 20000
+#define BENCHMARK_RNG_SAMPLES 100000
+#define BENCHMARK_DRAW_CALLS 2000
+#define BENCHMARK_SEED 1
+
+// Fonte de entrada: leitura bruta do acelerômetro (16384 = 1 g) no tick
+// dado; o benchmark passa pelo pipeline de tilt.h como no jogo (leitura
+// direta por quadro, sem giroscópio)
+typedef void (*BenchInputFn)(int tick, int16_t accel[3]);
+
+typedef struct {
+    const char *name;
+    uint32_t ticks;
+    uint32_t restarts;      // game over durante a medição
+    uint32_t update_ns;     // input + *_update, por tick
+    uint32_t draw_ns;       // *_draw no display_buffer, por tick
+    uint32_t flush_bytes;   // bytes que iriam para o I2C, por tick
+    uint32_t worst_ns;      // tick mais lento (update + draw)
+    uint32_t worst_tick;
+} BenchResult;
+
+void benchmark_synthetic_input(int tick, int16_t accel[3]);
+void benchmark_run(const Game *game, int ticks, BenchInputFn input, BenchResult *result);
+void benchmark_report(const BenchResult *results, int count);
+
+// Repete uma partida gravada (replay.h) com a mesma semente e a mesma
+// entrada por tick, medindo como benchmark_run. Retorna false se o jogo
+// não chegou ao mesmo tick final com a pontuação gravada (a repetição não
+// foi exata).
+bool benchmark_replay(const Game *game, ReplayReader *replay, BenchResult *result);
+
+// Pipeline de inclinação a 200 Hz com tremida: ciclos por amostra do caminho
+// antigo em float (bruto / 16384.0 + low_pass_filter + limiar 0.3 g) contra
+// a fusão com o giroscópio de tilt.h, erro médio de cada um em relação ao
+// ângulo real e quantas decisões de direção cada um erra
+void benchmark_tilt_pipeline(int samples);
+
+// Primitivas de desenho (retângulos cheios e contornos, texto e
+// clear_screen) contra o caminho antigo pixel a pixel: ns por chamada e se
+// o buffer resultante é o mesmo, com posições que passam pelas bordas
+void benchmark_draw(int calls);
+
+// Sorteio de posições como os jogos fazem: ciclos por número do rand() da
+// libc com "% bound" contra rng_below() de rng.h
+void benchmark_rng(int samples);
+
+#endif // BENCHMARK_H
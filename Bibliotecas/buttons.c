@@ -0,0 +1,136 @@
+#include "buttons.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <esp_attr.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char *TAG = "BUTTONS";
+
+// Estado de cada botão visto pela interrupção: último nível aceito e quando
+typedef struct {
+    gpio_num_t pin;
+    uint8_t id;
+    volatile int level;
+    volatile int64_t last_edge_us;
+} ButtonState;
+
+static ButtonState states[BUTTON_COUNT] = {
+    [BUTTON_SELECT] = { SELECT_BUTTON, BUTTON_SELECT, 0, 0 },
+    [BUTTON_NAVIGATE] = { NAVIGATE_BUTTON, BUTTON_NAVIGATE, 0, 0 },
+};
+
+static QueueHandle_t events = NULL;
+
+// Borda em qualquer sentido: vale se mudou o nível aceito e já passou a
+// janela de trepidação desde a última borda aceita
+static void IRAM_ATTR button_isr(void *arg) {
+    ButtonState *state = arg;
+    int64_t now = esp_timer_get_time();
+    int level = gpio_get_level(state->pin);
+
+    if (level == state->level || now - state->last_edge_us < BUTTONS_DEBOUNCE_US) return;
+    state->level = level;
+    state->last_edge_us = now;
+
+    ButtonEvent event = { state->id, level != 0, now };
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(events, &event, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+bool buttons_init() {
+    if (events != NULL) return true;
+
+    events = xQueueCreate(BUTTONS_QUEUE_LEN, sizeof(ButtonEvent));
+    if (events == NULL) {
+        ESP_LOGE(TAG, "Falha ao criar a fila de botões");
+        return false;
+    }
+
+    gpio_install_isr_service(0); // pode já ter sido instalado pelo sensor
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        ButtonState *state = &states[i];
+        gpio_set_direction(state->pin, GPIO_MODE_INPUT);
+        gpio_set_pull_mode(state->pin, GPIO_PULLDOWN_ONLY);
+        gpio_set_intr_type(state->pin, GPIO_INTR_ANYEDGE);
+        state->level = gpio_get_level(state->pin);
+        if (gpio_isr_handler_add(state->pin, button_isr, state) != ESP_OK) {
+            ESP_LOGE(TAG, "Falha ao instalar a interrupção do pino %d", state->pin);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool buttons_wait(ButtonEvent *event, TickType_t ticks_to_wait) {
+    if (events == NULL) return false;
+    return xQueueReceive(events, event, ticks_to_wait) == pdTRUE;
+}
+
+bool buttons_wait_press(ButtonId *button, TickType_t ticks_to_wait) {
+    ButtonEvent event;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t remaining = ticks_to_wait;
+
+    while (buttons_wait(&event, remaining)) {
+        if (event.pressed) {
+            *button = event.button;
+            return true;
+        }
+        if (ticks_to_wait != portMAX_DELAY) {
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            if (elapsed >= ticks_to_wait) return false;
+            remaining = ticks_to_wait - elapsed;
+        }
+    }
+    return false;
+}
+
+bool buttons_held(ButtonId button, uint32_t hold_ms) {
+    ButtonEvent event;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t limit = pdMS_TO_TICKS(hold_ms);
+
+    while (1) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= limit || !buttons_wait(&event, limit - elapsed)) {
+            return button_is_down(button);
+        }
+        if (event.button == button && !event.pressed) return false;
+    }
+}
+
+void buttons_flush() {
+    if (events == NULL) return;
+    xQueueReset(events);
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        states[i].level = gpio_get_level(states[i].pin);
+    }
+}
+
+bool button_is_down(ButtonId button) {
+    return gpio_get_level(states[button].pin) != 0;
+}
+
+// O despertar usa o tipo de interrupção do pino (nível); com a interrupção
+// desligada o pino só acorda o chip, sem disparar button_isr em sequência
+void buttons_arm_wakeup() {
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        gpio_intr_disable(states[i].pin);
+        gpio_wakeup_enable(states[i].pin, GPIO_INTR_HIGH_LEVEL);
+    }
+}
+
+void buttons_disarm_wakeup() {
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        gpio_wakeup_disable(states[i].pin);
+        gpio_set_intr_type(states[i].pin, GPIO_INTR_ANYEDGE);
+        gpio_intr_enable(states[i].pin);
+    }
+    buttons_flush();
+}
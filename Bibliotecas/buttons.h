@@ -0,0 +1,58 @@
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <driver/gpio.h>
+#include <freertos/FreeRTOS.h>
+
+// Botões de navegação (nível alto = pressionado, pull-down interno)
+#define SELECT_BUTTON GPIO_NUM_27
+#define NAVIGATE_BUTTON GPIO_NUM_4
+
+// Bordas a menos de 30 ms da última aceita são trepidação do contato
+#define BUTTONS_DEBOUNCE_US 30000
+#define BUTTONS_QUEUE_LEN 8
+
+// Aperto segurado por mais que isso é um aperto longo
+#define BUTTONS_LONG_PRESS_MS 600
+
+typedef enum {
+    BUTTON_SELECT = 0,
+    BUTTON_NAVIGATE,
+    BUTTON_COUNT
+} ButtonId;
+
+typedef struct {
+    uint8_t button;      // ButtonId
+    bool pressed;        // false = soltou
+    int64_t at_us;       // esp_timer_get_time() da borda
+} ButtonEvent;
+
+// Configura os pinos com interrupção nas duas bordas. Cada borda que passa
+// pelo filtro de tempo vira um ButtonEvent na fila, sem polling.
+bool buttons_init();
+
+// Próximo evento da fila; false se o prazo acabar
+bool buttons_wait(ButtonEvent *event, TickType_t ticks_to_wait);
+
+// Próximo aperto (ignora as soltadas); false se o prazo acabar
+bool buttons_wait_press(ButtonId *button, TickType_t ticks_to_wait);
+
+// Chamada logo depois do aperto do botão: true se ele continua pressionado
+// por hold_ms (aperto longo), false se soltou antes. Consome os eventos
+// desse intervalo.
+bool buttons_held(ButtonId button, uint32_t hold_ms);
+
+// Descarta os eventos pendentes (apertos feitos durante a partida) e
+// ressincroniza o estado com o nível atual dos pinos
+void buttons_flush();
+
+bool button_is_down(ButtonId button);
+
+// Light sleep: troca a interrupção de borda pelo despertar por nível alto
+// nos dois botões, e depois volta (descartando o aperto que acordou)
+void buttons_arm_wakeup();
+void buttons_disarm_wakeup();
+
+#endif // BUTTONS_H
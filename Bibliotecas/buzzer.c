@@ -0,0 +1,120 @@
+#include "buzzer.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
+
+static const char *TAG = "BUZZER";
+
+static QueueHandle_t note_queue = NULL;
+static SemaphoreHandle_t stop_request = NULL;
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+static const BuzzerNote food_notes[] = {
+    { 800, 50 },
+};
+
+static const BuzzerNote level_complete_notes[] = {
+    { 1000, 100 }, { 0, 50 }, { 1200, 150 },
+};
+
+static const BuzzerNote game_over_notes[] = {
+    { 300, 200 }, { 0, 100 }, { 200, 300 }, { 0, 100 }, { 150, 400 },
+};
+
+static const BuzzerNote new_record_notes[] = {
+    { 1000, 100 }, { 0, 50 }, { 1200, 100 }, { 0, 50 }, { 1500, 200 },
+};
+
+const BuzzerMelody melody_food = { food_notes, ARRAY_LEN(food_notes) };
+const BuzzerMelody melody_level_complete = { level_complete_notes, ARRAY_LEN(level_complete_notes) };
+const BuzzerMelody melody_game_over = { game_over_notes, ARRAY_LEN(game_over_notes) };
+const BuzzerMelody melody_new_record = { new_record_notes, ARRAY_LEN(new_record_notes) };
+
+static void buzzer_output(uint16_t freq_hz) {
+    if (freq_hz != 0) {
+        ledc_set_freq(BUZZER_LEDC_MODE, BUZZER_LEDC_TIMER, freq_hz);
+        ledc_set_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL, 128); // 50% duty cycle
+    } else {
+        ledc_set_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL, 0); // Desliga
+    }
+    ledc_update_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL);
+}
+
+static void buzzer_task(void *pvParameters) {
+    BuzzerNote note;
+
+    while (1) {
+        xQueueReceive(note_queue, &note, portMAX_DELAY);
+
+        // Um pedido de parada já atendido não vale para as notas novas
+        xSemaphoreTake(stop_request, 0);
+
+        buzzer_output(note.freq_hz);
+        // A duração é a espera pelo pedido de parada: buzzer_stop() corta
+        // a nota na hora
+        if (xSemaphoreTake(stop_request, pdMS_TO_TICKS(note.duration_ms)) == pdTRUE) {
+            xQueueReset(note_queue);
+        }
+
+        // Só silencia quando a fila esvaziou: notas seguidas não piscam o PWM
+        if (uxQueueMessagesWaiting(note_queue) == 0) {
+            buzzer_output(0);
+        }
+    }
+}
+
+void buzzer_init() {
+    ledc_timer_config_t timer_conf = {
+        .speed_mode = BUZZER_LEDC_MODE,
+        .duty_resolution = BUZZER_LEDC_DUTY_RES,
+        .timer_num = BUZZER_LEDC_TIMER,
+        .freq_hz = 2000,
+        .clk_cfg = LEDC_AUTO_CLK
+    };
+    ledc_timer_config(&timer_conf);
+
+    ledc_channel_config_t channel_conf = {
+        .gpio_num = BUZZER_PIN,
+        .speed_mode = BUZZER_LEDC_MODE,
+        .channel = BUZZER_LEDC_CHANNEL,
+        .timer_sel = BUZZER_LEDC_TIMER,
+        .duty = 0,
+        .hpoint = 0
+    };
+    ledc_channel_config(&channel_conf);
+
+    note_queue = xQueueCreate(BUZZER_QUEUE_LEN, sizeof(BuzzerNote));
+    stop_request = xSemaphoreCreateBinary();
+    if (note_queue == NULL || stop_request == NULL ||
+        xTaskCreatePinnedToCore(buzzer_task, "buzzer", 2048, NULL, BUZZER_TASK_PRIORITY,
+                                NULL, BUZZER_TASK_CORE) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar a tarefa do buzzer, jogos sem som");
+        note_queue = NULL;
+    }
+}
+
+bool buzzer_play(const BuzzerMelody *melody) {
+    if (note_queue == NULL) return false;
+    if (uxQueueSpacesAvailable(note_queue) < melody->count) return false;
+
+    for (int i = 0; i < melody->count; i++) {
+        xQueueSend(note_queue, &melody->notes[i], 0);
+    }
+    return true;
+}
+
+bool buzzer_play_tone(int frequency, int duration_ms) {
+    BuzzerNote note = { frequency, duration_ms };
+    BuzzerMelody single = { &note, 1 };
+    return buzzer_play(&single);
+}
+
+void buzzer_stop() {
+    if (note_queue == NULL) return;
+    xQueueReset(note_queue);
+    xSemaphoreGive(stop_request);
+}
@@ -0,0 +1,50 @@
+#ifndef BUZZER_H
+#define BUZZER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <driver/gpio.h>
+#include <driver/ledc.h>
+
+// Buzzer no LEDC (PWM a 50%)
+#define BUZZER_PIN GPIO_NUM_25
+#define BUZZER_LEDC_CHANNEL LEDC_CHANNEL_0
+#define BUZZER_LEDC_TIMER LEDC_TIMER_0
+#define BUZZER_LEDC_MODE LEDC_HIGH_SPEED_MODE
+#define BUZZER_LEDC_DUTY_RES LEDC_TIMER_8_BIT
+
+// Tarefa do som: consome a fila de notas, no núcleo do envio do display e
+// com prioridade abaixo dele (só mexe no LEDC entre uma nota e outra)
+#define BUZZER_TASK_CORE 0
+#define BUZZER_TASK_PRIORITY 3
+#define BUZZER_QUEUE_LEN 32
+
+typedef struct {
+    uint16_t freq_hz;      // 0 = pausa
+    uint16_t duration_ms;
+} BuzzerNote;
+
+typedef struct {
+    const BuzzerNote *notes;
+    uint8_t count;
+} BuzzerMelody;
+
+// Melodias prontas (tabelas em flash)
+extern const BuzzerMelody melody_food;
+extern const BuzzerMelody melody_level_complete;
+extern const BuzzerMelody melody_game_over;
+extern const BuzzerMelody melody_new_record;
+
+// Configura o LEDC e cria a tarefa do som
+void buzzer_init();
+
+// Nenhuma das chamadas abaixo espera o som: as notas entram na fila e a
+// tarefa toca em sequência. Uma melodia que não cabe inteira na fila é
+// descartada (retorna false).
+bool buzzer_play(const BuzzerMelody *melody);
+bool buzzer_play_tone(int frequency, int duration_ms);
+
+// Corta a nota atual e descarta as que estavam na fila
+void buzzer_stop();
+
+#endif // BUZZER_H
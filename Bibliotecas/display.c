@@ -0,0 +1,534 @@
+#include "display.h"
+#include "font5x7.h"
+#include "profiler.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
+
+static const char *TAG = "display";
+
+// Buffer de trás: onde os jogos desenham (alinhado para as escritas de 32 bits)
+uint8_t display_buffer[BUFFER_SIZE] __attribute__((aligned(4)));
+
+// Buffer da frente: quadro completo sendo enviado pela tarefa de envio
+static uint8_t display_front[BUFFER_SIZE];
+static uint8_t front_lo[PAGES];
+static uint8_t front_hi[PAGES];
+
+static TaskHandle_t flush_task = NULL;
+static SemaphoreHandle_t frame_ready = NULL;  // há quadro novo na frente
+static SemaphoreHandle_t flush_idle = NULL;   // frente livre para o próximo
+
+// Conteúdo atual da RAM do SSD1306 (o que já foi enviado)
+static uint8_t oled_shadow[BUFFER_SIZE];
+static bool shadow_valid = false;
+static bool damage_tracking = true;
+
+// Faixa de colunas alterada por página [lo, hi]; lo > hi indica página limpa
+static uint8_t dirty_lo[PAGES];
+static uint8_t dirty_hi[PAGES];
+
+// Faixa de colunas com pixels desenhados desde o último clear_screen()
+static uint8_t ink_lo[PAGES];
+static uint8_t ink_hi[PAGES];
+
+static DisplayStats stats;
+
+// Fundo estático e a faixa com tinta de cada página dele
+static uint8_t background[BUFFER_SIZE] __attribute__((aligned(4)));
+static uint8_t background_lo[PAGES];
+static uint8_t background_hi[PAGES];
+
+static void span_reset(uint8_t *lo, uint8_t *hi) {
+    for (int p = 0; p < PAGES; p++) {
+        lo[p] = WIDTH;
+        hi[p] = 0;
+    }
+}
+
+static inline void span_add(uint8_t *lo, uint8_t *hi, int page, int x0, int x1) {
+    if (x0 < lo[page]) lo[page] = x0;
+    if (x1 > hi[page]) hi[page] = x1;
+}
+
+static inline bool span_empty(const uint8_t *lo, const uint8_t *hi, int page) {
+    return lo[page] > hi[page];
+}
+
+// Marca a área [x0,x1] x [y0,y1] (já recortada) como desenhada
+static inline void damage_mark(int x0, int y0, int x1, int y1) {
+    for (int p = y0 / 8; p <= y1 / 8; p++) {
+        span_add(dirty_lo, dirty_hi, p, x0, x1);
+        span_add(ink_lo, ink_hi, p, x0, x1);
+    }
+}
+
+void ssd1306_init() {
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (OLED_I2C_ADDRESS << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+    i2c_master_write_byte(cmd, OLED_CMD_SET_CHARGE_PUMP, true);
+    i2c_master_write_byte(cmd, 0x14, true);
+    i2c_master_write_byte(cmd, OLED_CMD_SET_SEGMENT_REMAP, true);
+    i2c_master_write_byte(cmd, OLED_CMD_SET_COM_SCAN_MODE, true);
+    // Endereçamento horizontal: necessário para as janelas de coluna/página
+    i2c_master_write_byte(cmd, OLED_CMD_SET_MEMORY_ADDR_MODE, true);
+    i2c_master_write_byte(cmd, 0x00, true);
+    i2c_master_write_byte(cmd, OLED_CMD_DISPLAY_ON, true);
+    i2c_master_stop(cmd);
+
+    esp_err_t ret = i2c_bus_transfer(cmd, 10 / portTICK_PERIOD_MS);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao inicializar o SSD1306: %s", esp_err_to_name(ret));
+    }
+    i2c_cmd_link_delete(cmd);
+
+    span_reset(dirty_lo, dirty_hi);
+    span_reset(ink_lo, ink_hi);
+    span_reset(background_lo, background_hi);
+    display_invalidate();
+}
+
+void display_set_power(bool on) {
+    display_wait_flush();
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (OLED_I2C_ADDRESS << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+    i2c_master_write_byte(cmd, on ? OLED_CMD_DISPLAY_ON : OLED_CMD_DISPLAY_OFF, true);
+    i2c_master_stop(cmd);
+
+    esp_err_t ret = i2c_bus_transfer(cmd, 10 / portTICK_PERIOD_MS);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao %s o display: %s", on ? "ligar" : "desligar", esp_err_to_name(ret));
+    }
+    i2c_cmd_link_delete(cmd);
+}
+
+// Só zera as faixas com tinta: o custo acompanha o que foi desenhado
+void clear_screen() {
+    for (int p = 0; p < PAGES; p++) {
+        if (span_empty(ink_lo, ink_hi, p)) continue;
+
+        // O que estava desenhado será apagado na tela: vira área alterada
+        memset(&display_buffer[p * WIDTH + ink_lo[p]], 0, ink_hi[p] - ink_lo[p] + 1);
+        span_add(dirty_lo, dirty_hi, p, ink_lo[p], ink_hi[p]);
+    }
+    span_reset(ink_lo, ink_hi);
+}
+
+// Janela retangular de páginas/colunas enviada numa única transação de dados
+typedef struct {
+    uint8_t page0, page1;
+    uint8_t col0, col1;
+} FlushWindow;
+
+#define MAX_WINDOWS (PAGES * 4)
+
+static uint32_t window_bytes(const FlushWindow *w) {
+    // Cabeçalho de comandos (8) + endereço/controle dos dados (2) + dados
+    return 8 + 2 + (w->col1 - w->col0 + 1) * (w->page1 - w->page0 + 1);
+}
+
+// Acrescenta ao comando uma janela página/coluna seguida dos dados
+static void queue_window(i2c_cmd_handle_t cmd, const uint8_t *frame, const FlushWindow *w) {
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (OLED_I2C_ADDRESS << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_CMD_STREAM, true);
+    i2c_master_write_byte(cmd, OLED_CMD_SET_COLUMN_RANGE, true);
+    i2c_master_write_byte(cmd, w->col0, true);
+    i2c_master_write_byte(cmd, w->col1, true);
+    i2c_master_write_byte(cmd, OLED_CMD_SET_PAGE_RANGE, true);
+    i2c_master_write_byte(cmd, w->page0, true);
+    i2c_master_write_byte(cmd, w->page1, true);
+
+    int width = w->col1 - w->col0 + 1;
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (OLED_I2C_ADDRESS << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, OLED_CONTROL_BYTE_DATA_STREAM, true);
+    for (int p = w->page0; p <= w->page1; p++) {
+        i2c_master_write(cmd, &frame[p * WIDTH + w->col0], width, true);
+    }
+}
+
+// Divide a faixa alterada de uma página em trechos realmente diferentes
+// da RAM do display. Retorna o número de trechos gravados em seg_lo/seg_hi.
+static int page_segments(const uint8_t *frame, int page, int lo, int hi,
+                         uint8_t *seg_lo, uint8_t *seg_hi, int max_segs) {
+    const uint8_t *row = &frame[page * WIDTH];
+    const uint8_t *old = &oled_shadow[page * WIDTH];
+    int count = 0;
+
+    for (int x = lo; x <= hi; x++) {
+        if (row[x] == old[x]) continue;
+
+        if (count > 0 && x - seg_hi[count - 1] <= DISPLAY_MIN_WINDOW_GAP) {
+            seg_hi[count - 1] = x;
+        } else if (count < max_segs) {
+            seg_lo[count] = x;
+            seg_hi[count] = x;
+            count++;
+        } else {
+            seg_hi[count - 1] = x;
+        }
+    }
+    return count;
+}
+
+// Decide quais janelas de `frame` precisam ir para o display
+static int plan_windows(const uint8_t *frame, const uint8_t *lo, const uint8_t *hi, FlushWindow *windows) {
+    uint8_t seg_lo[PAGES][4];
+    uint8_t seg_hi[PAGES][4];
+    int seg_count[PAGES];
+    int count = 0;
+
+    if (!damage_tracking || !shadow_valid) {
+        windows[0] = (FlushWindow){ 0, PAGES - 1, 0, WIDTH - 1 };
+        return 1;
+    }
+
+    for (int p = 0; p < PAGES; p++) {
+        seg_count[p] = span_empty(lo, hi, p) ? 0 : page_segments(frame, p, lo[p], hi[p], seg_lo[p], seg_hi[p], 4);
+    }
+
+    for (int p = 0; p < PAGES; p++) {
+        // Páginas seguidas com o mesmo trecho único viram uma janela só
+        if (seg_count[p] == 1) {
+            int last = p;
+            while (last + 1 < PAGES && seg_count[last + 1] == 1 &&
+                   seg_lo[last + 1][0] == seg_lo[p][0] &&
+                   seg_hi[last + 1][0] == seg_hi[p][0]) {
+                last++;
+            }
+            windows[count++] = (FlushWindow){ p, last, seg_lo[p][0], seg_hi[p][0] };
+            p = last;
+            continue;
+        }
+        for (int s = 0; s < seg_count[p]; s++) {
+            windows[count++] = (FlushWindow){ p, p, seg_lo[p][s], seg_hi[p][s] };
+        }
+    }
+    return count;
+}
+
+// Envia ao SSD1306 as partes de `frame` marcadas em lo/hi e atualiza a sombra
+static void flush_frame(const uint8_t *frame, const uint8_t *lo, const uint8_t *hi) {
+    PROFILE_SCOPE(PROF_FLUSH);
+    FlushWindow windows[MAX_WINDOWS];
+    int count = plan_windows(frame, lo, hi, windows);
+
+    stats.flushes++;
+
+    if (count > 0) {
+        i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+        for (int i = 0; i < count; i++) {
+            queue_window(cmd, frame, &windows[i]);
+            stats.windows++;
+            stats.bytes_sent += window_bytes(&windows[i]);
+        }
+        i2c_master_stop(cmd);
+
+        esp_err_t ret = i2c_bus_transfer(cmd, 100 / portTICK_PERIOD_MS);
+        i2c_cmd_link_delete(cmd);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Falha ao atualizar o display: %s", esp_err_to_name(ret));
+            shadow_valid = false;
+            return;
+        }
+    }
+
+    memcpy(oled_shadow, frame, BUFFER_SIZE);
+    shadow_valid = true;
+}
+
+static void display_flush_task(void *pvParameters) {
+    while (1) {
+        xSemaphoreTake(frame_ready, portMAX_DELAY);
+        flush_frame(display_front, front_lo, front_hi);
+        span_reset(front_lo, front_hi);
+        xSemaphoreGive(flush_idle);
+    }
+}
+
+void display_start_flush_task(int core) {
+    if (flush_task != NULL) return;
+
+    frame_ready = xSemaphoreCreateBinary();
+    flush_idle = xSemaphoreCreateBinary();
+    span_reset(front_lo, front_hi);
+    xSemaphoreGive(flush_idle);
+
+    if (xTaskCreatePinnedToCore(display_flush_task, "display_flush", 3072, NULL,
+                                DISPLAY_FLUSH_PRIORITY, &flush_task, core) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar a tarefa de envio do display");
+        flush_task = NULL;
+    }
+}
+
+void display_wait_flush() {
+    if (flush_task == NULL) return;
+    xSemaphoreTake(flush_idle, portMAX_DELAY);
+    xSemaphoreGive(flush_idle);
+}
+
+void display_present() {
+    if (flush_task == NULL) {
+        flush_frame(display_buffer, dirty_lo, dirty_hi);
+        span_reset(dirty_lo, dirty_hi);
+        return;
+    }
+
+    // Cerca: o quadro anterior precisa ter saído antes de sobrescrever a frente
+    xSemaphoreTake(flush_idle, portMAX_DELAY);
+    memcpy(display_front, display_buffer, BUFFER_SIZE);
+    for (int p = 0; p < PAGES; p++) {
+        if (!span_empty(dirty_lo, dirty_hi, p)) {
+            span_add(front_lo, front_hi, p, dirty_lo[p], dirty_hi[p]);
+        }
+    }
+    span_reset(dirty_lo, dirty_hi);
+    xSemaphoreGive(frame_ready);
+}
+
+void update_display() {
+    display_present();
+    display_wait_flush();
+}
+
+// Calcula quantos bytes o próximo envio colocaria no barramento e dá o
+// quadro como enviado, sem tocar no I2C. Só vale sem a tarefa de envio.
+uint32_t display_measure_flush() {
+    FlushWindow windows[MAX_WINDOWS];
+    int count = plan_windows(display_buffer, dirty_lo, dirty_hi, windows);
+    uint32_t bytes = 0;
+
+    for (int i = 0; i < count; i++) {
+        bytes += window_bytes(&windows[i]);
+    }
+    memcpy(oled_shadow, display_buffer, BUFFER_SIZE);
+    shadow_valid = true;
+    span_reset(dirty_lo, dirty_hi);
+    return bytes;
+}
+
+void draw_pixel(int x, int y, bool on) {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+
+    if (on) {
+        display_buffer[x + (y / 8) * WIDTH] |= (1 << (y % 8));
+    } else {
+        display_buffer[x + (y / 8) * WIDTH] &= ~(1 << (y % 8));
+    }
+    damage_mark(x, y, x, y);
+}
+
+// Palavra de 4 bytes do buffer; may_alias porque o buffer é de uint8_t
+typedef uint32_t __attribute__((may_alias)) display_word_t;
+
+// OR de `mask` nas colunas [x0, x1] de uma linha de página: bytes até
+// alinhar, depois palavras de 32 bits com a máscara repetida
+static inline void or_span(uint8_t *row, int x0, int x1, uint8_t mask) {
+    if (mask == 0xFF) {
+        memset(&row[x0], 0xFF, x1 - x0 + 1);
+        return;
+    }
+    int x = x0;
+    for (; x <= x1 && ((uintptr_t)&row[x] & 3); x++) row[x] |= mask;
+
+    uint32_t word = mask * 0x01010101u;
+    for (; x + 3 <= x1; x += 4) *(display_word_t *)&row[x] |= word;
+
+    for (; x <= x1; x++) row[x] |= mask;
+}
+
+// Preenche [x0,x1] x [y0,y1] com recorte: uma faixa de bytes por página,
+// com a máscara vertical das páginas da borda
+static void fill_area(int x0, int y0, int x1, int y1) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= WIDTH) x1 = WIDTH - 1;
+    if (y1 >= HEIGHT) y1 = HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    int p0 = y0 / 8, p1 = y1 / 8;
+    for (int p = p0; p <= p1; p++) {
+        uint8_t mask = 0xFF;
+        if (p == p0) mask &= 0xFF << (y0 % 8);
+        if (p == p1) mask &= 0xFF >> (7 - y1 % 8);
+        or_span(&display_buffer[p * WIDTH], x0, x1, mask);
+    }
+    damage_mark(x0, y0, x1, y1);
+}
+
+void draw_rect(int x, int y, int width, int height, bool fill) {
+    if (width <= 0 || height <= 0) return;
+    int x1 = x + width - 1, y1 = y + height - 1;
+
+    if (fill) {
+        fill_area(x, y, x1, y1);
+        return;
+    }
+    // Contorno: duas linhas (faixas por página) e duas colunas (um byte por página)
+    fill_area(x, y, x1, y);
+    fill_area(x, y1, x1, y1);
+    fill_area(x, y, x, y1);
+    fill_area(x1, y, x1, y1);
+}
+
+// As colunas do glifo já estão no formato da página: deslocadas pelo resto
+// de y, cada uma cai em no máximo dois bytes
+void draw_char(int x, int y, char c) {
+    if (c < 32 || c > 126) return;
+    if (x <= -FONT5X7_WIDTH || x >= WIDTH || y <= -FONT5X7_HEIGHT || y >= HEIGHT) return;
+
+    const uint8_t *glyph = font5x7_basic[c - 32];
+    int page = (y + 8) / 8 - 1; // arredonda para baixo também com y negativo
+    int shift = y - page * 8;
+    int lo = WIDTH, hi = -1;
+
+    for (int i = 0; i < FONT5X7_WIDTH; i++) {
+        int col = x + i;
+        uint16_t bits = (uint16_t)((glyph[i] & 0x7F) << shift);
+        if (col < 0 || col >= WIDTH || bits == 0) continue;
+
+        if (page >= 0) display_buffer[page * WIDTH + col] |= bits & 0xFF;
+        if (page + 1 < PAGES) display_buffer[(page + 1) * WIDTH + col] |= bits >> 8;
+        if (lo == WIDTH) lo = col;
+        hi = col;
+    }
+    if (hi >= 0) {
+        damage_mark(lo, y < 0 ? 0 : y, hi,
+                    y + FONT5X7_HEIGHT - 1 < HEIGHT ? y + FONT5X7_HEIGHT - 1 : HEIGHT - 1);
+    }
+}
+
+void draw_text(int x, int y, const char *text) {
+    while (*text) {
+        draw_char(x, y, *text++);
+        x += FONT5X7_WIDTH + 1;
+    }
+}
+
+// Combina (OR) uma camada de tela inteira, no layout do display_buffer
+void draw_layer(const uint8_t *layer) {
+    for (int p = 0; p < PAGES; p++) {
+        const uint8_t *src = &layer[p * WIDTH];
+        uint8_t *dst = &display_buffer[p * WIDTH];
+        int lo = WIDTH, hi = -1;
+
+        for (int x = 0; x < WIDTH; x++) {
+            if (src[x] == 0) continue;
+            dst[x] |= src[x];
+            if (lo == WIDTH) lo = x;
+            hi = x;
+        }
+        if (hi >= 0) {
+            span_add(dirty_lo, dirty_hi, p, lo, hi);
+            span_add(ink_lo, ink_hi, p, lo, hi);
+        }
+    }
+}
+
+void display_set_background() {
+    memcpy(background, display_buffer, BUFFER_SIZE);
+    memcpy(background_lo, ink_lo, PAGES);
+    memcpy(background_hi, ink_hi, PAGES);
+}
+
+void draw_background() {
+    for (int p = 0; p < PAGES; p++) {
+        if (span_empty(background_lo, background_hi, p)) continue;
+
+        int lo = background_lo[p], hi = background_hi[p];
+        const uint8_t *src = &background[p * WIDTH];
+        uint8_t *dst = &display_buffer[p * WIDTH];
+
+        // Página ainda limpa (o caso comum, logo após o clear_screen()): cópia
+        if (span_empty(ink_lo, ink_hi, p)) {
+            memcpy(&dst[lo], &src[lo], hi - lo + 1);
+        } else {
+            int x = lo;
+            for (; x <= hi && (x & 3); x++) dst[x] |= src[x];
+            for (; x + 3 <= hi; x += 4) {
+                *(display_word_t *)&dst[x] |= *(const display_word_t *)&src[x];
+            }
+            for (; x <= hi; x++) dst[x] |= src[x];
+        }
+        span_add(dirty_lo, dirty_hi, p, lo, hi);
+        span_add(ink_lo, ink_hi, p, lo, hi);
+    }
+}
+
+void hud_number_init(HudNumber *number, int x, int y) {
+    number->x = x;
+    number->y = y;
+    number->valid = false;
+}
+
+// Texto do valor nas duas páginas a partir de y / 8, já deslocado pelo resto
+static void hud_number_raster(HudNumber *number, int value) {
+    char digits[HUD_NUMBER_MAX_CHARS];
+    int count = 0;
+    unsigned magnitude = value < 0 ? -(unsigned)value : (unsigned)value;
+
+    do {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude && count < HUD_NUMBER_MAX_CHARS - (value < 0));
+    if (value < 0) digits[count++] = '-';
+
+    int shift = number->y % 8;
+    memset(number->strip, 0, sizeof(number->strip));
+    for (int c = 0; c < count; c++) {
+        const uint8_t *glyph = font5x7_basic[digits[count - 1 - c] - 32];
+        for (int i = 0; i < FONT5X7_WIDTH; i++) {
+            uint16_t bits = (uint16_t)((glyph[i] & 0x7F) << shift);
+            number->strip[0][c * HUD_CHAR_WIDTH + i] = bits & 0xFF;
+            number->strip[1][c * HUD_CHAR_WIDTH + i] = bits >> 8;
+        }
+    }
+    number->cols = count * HUD_CHAR_WIDTH - 1;
+    number->value = value;
+    number->valid = true;
+}
+
+void draw_hud_number(HudNumber *number, int value) {
+    if (!number->valid || number->value != value) {
+        hud_number_raster(number, value);
+    }
+
+    int page = number->y / 8;
+    int x0 = number->x < 0 ? 0 : number->x;
+    int x1 = number->x + number->cols - 1;
+    if (x1 >= WIDTH) x1 = WIDTH - 1;
+    if (x0 > x1 || page >= PAGES) return;
+
+    for (int row = 0; row < 2 && page + row < PAGES; row++) {
+        const uint8_t *src = &number->strip[row][x0 - number->x];
+        uint8_t *dst = &display_buffer[(page + row) * WIDTH + x0];
+        for (int x = 0; x <= x1 - x0; x++) dst[x] |= src[x];
+    }
+    int y1 = number->y + FONT5X7_HEIGHT - 1;
+    damage_mark(x0, number->y, x1, y1 < HEIGHT ? y1 : HEIGHT - 1);
+}
+
+void display_set_damage_tracking(bool enabled) {
+    damage_tracking = enabled;
+}
+
+// Força o próximo update_display() a reenviar a tela inteira
+void display_invalidate() {
+    shadow_valid = false;
+}
+
+void display_get_stats(DisplayStats *out) {
+    *out = stats;
+}
+
+void display_reset_stats() {
+    memset(&stats, 0, sizeof(stats));
+}
@@ -1,9 +1,10 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
-#include <driver/i2c.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include "i2c_bus.h"
 
 // Definições do display OLED
 #define OLED_I2C_ADDRESS 0x3C
@@ -15,28 +16,89 @@
 #define OLED_CMD_SET_SEGMENT_REMAP 0xA1
 #define OLED_CMD_SET_COM_SCAN_MODE 0xC8
 #define OLED_CMD_DISPLAY_ON 0xAF
+#define OLED_CMD_DISPLAY_OFF 0xAE
 #define OLED_CMD_SET_MEMORY_ADDR_MODE 0x20
 #define OLED_CMD_SET_COLUMN_RANGE 0x21
 #define OLED_CMD_SET_PAGE_RANGE 0x22
 
-// Definições de pinos
-#define SDA_PIN GPIO_NUM_21
-#define SCL_PIN GPIO_NUM_22
-
 // Configurações do display
 #define WIDTH 128
 #define HEIGHT 64
+#define PAGES (HEIGHT / 8)
 #define BUFFER_SIZE (WIDTH * HEIGHT / 8)
 
+// Trechos inalterados menores que isso são reenviados em vez de abrir
+// uma nova janela (o cabeçalho de uma janela custa ~8 bytes no barramento)
+#define DISPLAY_MIN_WINDOW_GAP 8
+
+// Tarefa de envio do display (roda no núcleo oposto ao game_task)
+#define DISPLAY_FLUSH_CORE 0
+#define DISPLAY_FLUSH_PRIORITY 6
+
+// Desenhe só pelas funções abaixo: clear_screen() apaga apenas as faixas
+// que elas marcaram como desenhadas
 extern uint8_t display_buffer[BUFFER_SIZE];
 
-void i2c_master_init();
+// Estatísticas de tráfego no barramento I2C
+typedef struct {
+    uint32_t flushes;      // quadros enviados
+    uint32_t windows;      // janelas página/coluna enviadas
+    uint32_t bytes_sent;   // bytes no barramento (endereço + controle + dados)
+} DisplayStats;
+
 void ssd1306_init();
+
+// Liga/desliga o painel (a RAM do SSD1306 é mantida; desligado ele consome
+// poucos uA). Espera o envio em andamento antes de desligar.
+void display_set_power(bool on);
 void clear_screen();
 void update_display();
 void draw_pixel(int x, int y, bool on);
 void draw_rect(int x, int y, int width, int height, bool fill);
 void draw_char(int x, int y, char c);
 void draw_text(int x, int y, const char *text);
+void draw_layer(const uint8_t *layer);
+
+// Fundo estático (paredes, rótulos, recorde): desenhado uma vez com as
+// funções acima e guardado por display_set_background(). A cada quadro,
+// draw_background() o compõe logo depois do clear_screen(), copiando só as
+// faixas de cada página que têm tinta. Há um fundo só, como há um display.
+void display_set_background();
+void draw_background();
+
+// Número do HUD: o texto fica rasterizado nas duas páginas que ele cruza e
+// só é refeito quando o valor muda. Desenha como draw_text (y >= 0).
+#define HUD_CHAR_WIDTH 6
+#define HUD_NUMBER_MAX_CHARS 7
+
+typedef struct {
+    int16_t x, y;
+    int value;
+    uint8_t cols;
+    bool valid;
+    uint8_t strip[2][HUD_NUMBER_MAX_CHARS * HUD_CHAR_WIDTH];
+} HudNumber;
+
+void hud_number_init(HudNumber *number, int x, int y);
+void draw_hud_number(HudNumber *number, int value);
+
+// Rastreamento de áreas alteradas: quando ativo, update_display() envia só
+// as janelas de página/coluna que mudaram desde o último envio
+void display_set_damage_tracking(bool enabled);
+void display_invalidate();
+void display_get_stats(DisplayStats *stats);
+void display_reset_stats();
+
+// Buffer duplo: display_buffer é o buffer de trás. display_present() espera o
+// envio anterior terminar, copia o quadro para a frente e retorna sem esperar
+// o I2C; display_wait_flush() é a cerca que aguarda o envio em andamento.
+// Sem a tarefa iniciada, display_present() envia na hora. update_display()
+// continua síncrono (present + wait).
+void display_start_flush_task(int core);
+void display_present();
+void display_wait_flush();
+
+// Para benchmarks: bytes que o próximo envio custaria, sem usar o barramento
+uint32_t display_measure_flush();
 
 #endif // DISPLAY_H
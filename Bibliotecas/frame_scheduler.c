@@ -0,0 +1,74 @@
+#include "frame_scheduler.h"
+
+#include <freertos/task.h>
+#include <esp_timer.h>
+
+void frame_scheduler_init(FrameScheduler *sched, uint32_t tick_ms, uint32_t frame_ms) {
+    sched->tick_us = (int64_t)tick_ms * 1000;
+    sched->frame_ticks = pdMS_TO_TICKS(frame_ms);
+    if (sched->frame_ticks == 0) sched->frame_ticks = 1;
+    sched->skipped_frames = 0;
+    sched->dropped_ticks = 0;
+    frame_scheduler_reset(sched);
+}
+
+// Recomeça a contagem a partir de agora (ex.: depois de uma pausa longa)
+void frame_scheduler_reset(FrameScheduler *sched) {
+    sched->next_tick_us = esp_timer_get_time() + sched->tick_us;
+    sched->last_wake = xTaskGetTickCount();
+    sched->unrendered = true;
+    sched->skip_render = false;
+    sched->skipped_in_row = 0;
+}
+
+// Início do quadro: retorna quantos ticks de simulação devem rodar agora
+int frame_scheduler_begin(FrameScheduler *sched) {
+    int64_t now = esp_timer_get_time();
+    int ticks = 0;
+
+    sched->frame_start_us = now;
+    while (now >= sched->next_tick_us && ticks < FRAME_SCHEDULER_MAX_CATCHUP) {
+        sched->next_tick_us += sched->tick_us;
+        ticks++;
+    }
+
+    // Atraso grande demais: descarta o restante em vez de acelerar o jogo
+    if (now >= sched->next_tick_us) {
+        int64_t behind = (now - sched->next_tick_us) / sched->tick_us + 1;
+        sched->dropped_ticks += behind;
+        sched->next_tick_us += behind * sched->tick_us;
+    }
+
+    if (ticks > 0) sched->unrendered = true;
+    return ticks;
+}
+
+bool frame_scheduler_should_render(FrameScheduler *sched) {
+    if (!sched->unrendered) return false;
+    if (sched->skip_render) {
+        sched->skipped_frames++;
+        return false;
+    }
+    sched->unrendered = false;
+    return true;
+}
+
+// Fim do quadro: espera o próximo período; se o quadro estourou o período,
+// o próximo render é pulado para a simulação alcançar o relógio
+void frame_scheduler_end(FrameScheduler *sched) {
+    int64_t elapsed = esp_timer_get_time() - sched->frame_start_us;
+    int64_t frame_us = (int64_t)sched->frame_ticks * portTICK_PERIOD_MS * 1000;
+
+    if (elapsed > frame_us) {
+        // Retoma a partir de agora sem esperar; sem isto o vTaskDelayUntil
+        // devolveria vários quadros em rajada para compensar o atraso
+        sched->last_wake = xTaskGetTickCount() - sched->frame_ticks;
+        sched->skip_render = sched->skipped_in_row < FRAME_SCHEDULER_MAX_SKIP;
+        sched->skipped_in_row = sched->skip_render ? sched->skipped_in_row + 1 : 0;
+    } else {
+        sched->skip_render = false;
+        sched->skipped_in_row = 0;
+    }
+
+    vTaskDelayUntil(&sched->last_wake, sched->frame_ticks);
+}
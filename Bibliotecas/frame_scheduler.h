@@ -0,0 +1,35 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <freertos/FreeRTOS.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Quadros seguidos que podem ser pulados quando o render atrasa
+#define FRAME_SCHEDULER_MAX_SKIP 3
+// Ticks de simulação recuperados por quadro antes de descartar o atraso
+#define FRAME_SCHEDULER_MAX_CATCHUP 4
+
+// Laço de passo fixo: a simulação avança em ticks de período constante
+// (medidos com esp_timer), independentes do período de quadro, que controla
+// leitura do sensor e render e é mantido com vTaskDelayUntil.
+typedef struct {
+    int64_t tick_us;          // período da simulação
+    int64_t next_tick_us;     // instante do próximo tick de simulação
+    int64_t frame_start_us;
+    TickType_t frame_ticks;   // período de quadro em ticks do FreeRTOS
+    TickType_t last_wake;
+    bool unrendered;          // houve tick desde o último render
+    bool skip_render;
+    int skipped_in_row;
+    uint32_t skipped_frames;  // total de renders pulados
+    uint32_t dropped_ticks;   // ticks descartados por atraso excessivo
+} FrameScheduler;
+
+void frame_scheduler_init(FrameScheduler *sched, uint32_t tick_ms, uint32_t frame_ms);
+void frame_scheduler_reset(FrameScheduler *sched);
+int frame_scheduler_begin(FrameScheduler *sched);
+bool frame_scheduler_should_render(FrameScheduler *sched);
+void frame_scheduler_end(FrameScheduler *sched);
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,41 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "buzzer.h"
+#include "tilt.h"
+
+// Um jogo visto pelo loop do game_task e pelo benchmark. state aponta para
+// state_size bytes; seed vai para o gerador do jogo (rng.h). O loop chama
+// input + update a cada tick e draw quando há quadro, então um jogo novo é
+// só mais uma entrada na tabela, sem mexer no game_task.
+typedef struct {
+    const char *name;                  // recordes e replays ("snake")
+    const char *title;                 // menu e telas ("Snake")
+    const char *end_text;              // título da tela final
+    const BuzzerMelody *end_melody;    // sem recorde novo
+    size_t state_size;
+    uint16_t tick_ms;                  // tick da simulação
+    uint16_t frame_ms;                 // quadro (leitura do sensor + render)
+
+    void (*init)(void *state, uint32_t seed);
+    void (*input)(void *state, const TiltInput *tilt);
+    void (*update)(void *state);
+    void (*draw)(void *state);                       // só desenha no buffer
+    bool (*game_over)(const void *state);
+    int (*score)(const void *state);
+
+    // Opcionais (NULL em jogos de fase única): com a fase concluída os ticks
+    // param, o loop mostra o quadro, pausa e chama next_level, que carrega a
+    // próxima ou encerra a partida
+    bool (*level_complete)(const void *state);
+    void (*next_level)(void *state);
+} Game;
+
+static inline bool game_level_complete(const Game *game, const void *state) {
+    return game->level_complete != NULL && game->level_complete(state);
+}
+
+#endif // GAME_H
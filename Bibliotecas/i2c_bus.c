@@ -0,0 +1,36 @@
+#include "i2c_bus.h"
+
+#include <freertos/semphr.h>
+
+// Mutex do barramento (com herança de prioridade: a tarefa do sensor, mais
+// prioritária, não fica presa atrás de quem está com o barramento)
+static SemaphoreHandle_t bus_lock = NULL;
+
+void i2c_master_init() {
+    i2c_config_t conf = {
+        .mode = I2C_MODE_MASTER,
+        .sda_io_num = SDA_PIN,
+        .scl_io_num = SCL_PIN,
+        .sda_pullup_en = GPIO_PULLUP_ENABLE,
+        .scl_pullup_en = GPIO_PULLUP_ENABLE,
+        .master.clk_speed = I2C_BUS_FREQ_HZ,
+    };
+    i2c_param_config(I2C_BUS_PORT, &conf);
+    i2c_driver_install(I2C_BUS_PORT, conf.mode, 0, 0, 0);
+
+    if (bus_lock == NULL) {
+        bus_lock = xSemaphoreCreateMutex();
+    }
+}
+
+esp_err_t i2c_bus_transfer(i2c_cmd_handle_t cmd, TickType_t ticks_to_wait) {
+    if (bus_lock == NULL) {
+        return i2c_master_cmd_begin(I2C_BUS_PORT, cmd, ticks_to_wait);
+    }
+    if (xSemaphoreTake(bus_lock, ticks_to_wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    esp_err_t ret = i2c_master_cmd_begin(I2C_BUS_PORT, cmd, ticks_to_wait);
+    xSemaphoreGive(bus_lock);
+    return ret;
+}
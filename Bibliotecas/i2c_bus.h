@@ -0,0 +1,22 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+
+// Barramento I2C compartilhado pelo display e pelo MPU6050
+#define SDA_PIN GPIO_NUM_21
+#define SCL_PIN GPIO_NUM_22
+#define I2C_BUS_PORT I2C_NUM_0
+#define I2C_BUS_FREQ_HZ 400000
+
+void i2c_master_init();
+
+// Executa uma transação com o barramento travado: o envio do display e as
+// leituras do sensor rodam em tarefas diferentes e nunca se misturam. Todo
+// acesso depois do boot passa por aqui; só o mpu6050_init() da biblioteca
+// externa usa o driver direto, antes de as tarefas existirem.
+// Retorna ESP_ERR_TIMEOUT se o barramento não ficou livre a tempo.
+esp_err_t i2c_bus_transfer(i2c_cmd_handle_t cmd, TickType_t ticks_to_wait);
+
+#endif // I2C_BUS_H
@@ -2,9 +2,9 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <driver/gpio.h>
-#include <driver/ledc.h>
 #include <esp_log.h>
 #include <esp_err.h>
+#include <esp_random.h>
 #include <stdlib.h>
 #include <math.h>
 
@@ -12,20 +12,61 @@
 #include "display.h"
 #include "mpu6050.h"
 #include "sdcard.h"
-
-// Botões de navegação
-#define SELECT_BUTTON GPIO_NUM_27
-#define NAVIGATE_BUTTON GPIO_NUM_4
+#include "frame_scheduler.h"
+#include "profiler.h"
+#include "benchmark.h"
+#include "maze_levels.h"
+#include "sensor.h"
+#include "buzzer.h"
+#include "scores.h"
+#include "replay.h"
+#include "rng.h"
+#include "physics.h"
+#include "buttons.h"
+#include "power.h"
+#include "game.h"
+#include "arena.h"
 
 // Configurações gerais
 #define GAME_SPEED 300 // ms
 
-// BUZZER
-#define BUZZER_PIN GPIO_NUM_25
-#define BUZZER_LEDC_CHANNEL LEDC_CHANNEL_0
-#define BUZZER_LEDC_TIMER LEDC_TIMER_0
-#define BUZZER_LEDC_MODE LEDC_HIGH_SPEED_MODE
-#define BUZZER_LEDC_DUTY_RES LEDC_TIMER_8_BIT
+// Períodos por jogo: tick da simulação / quadro (leitura do sensor + render)
+#define SNAKE_TICK_MS GAME_SPEED
+#define SNAKE_FRAME_MS 50
+#define PONG_TICK_MS 30
+#define PONG_FRAME_MS 30
+#define DODGE_TICK_MS DODGE_FRAME_MS
+#define DODGE_FRAME_MS 50
+#define TILT_MAZE_TICK_MS GAME_SPEED
+#define TILT_MAZE_FRAME_MS 50
+
+// Pilha do game_task: o estado da partida fica na arena, então sobra só o
+// que o menu, as telas e o cartão SD usam. A cada partida o log mostra quanto
+// nunca foi usado; abaixo da margem, avisa. Fica nos 8192 de antes até esse
+// relatório, medido no aparelho, justificar um valor menor.
+#define GAME_TASK_STACK_SIZE 8192
+#define GAME_TASK_STACK_MARGIN 1024
+
+// Pong: velocidade da bola (rampa a cada rebatida) e ângulo de saída pela
+// distância do centro da raquete. O saque tem o ritmo do jogo original (2 px
+// em cada eixo a cada 300 ms), independente do tick de 30 ms; a rampa chega
+// a pouco mais do dobro.
+#define PONG_BALL_SPEED FX_PER_TICK(9.43, PONG_TICK_MS)     // ~0.28 px/tick
+#define PONG_BALL_SPEED_STEP FX_PER_TICK(0.6, PONG_TICK_MS)
+#define PONG_BALL_SPEED_MAX FX_PER_TICK(20, PONG_TICK_MS)   // 0.6 px/tick
+#define PONG_SERVE_ANGLE 6                                   // 45 graus
+#define PONG_PADDLE_LINE FX_FROM_INT(HEIGHT - 4)             // contato da bola
+
+// Dodge: queda dos blocos, acelerando a cada 10 pontos, e o jogador com 90
+// graus de inclinação. Mesmo ritmo do tick de 300 ms original (2 px de queda
+// e 8 px de jogador por tick), agora em frações de pixel a cada quadro.
+#define DODGE_BLOCK_SPEED FX_PER_TICK(6.67, DODGE_TICK_MS)   // ~0.33 px/tick
+#define DODGE_BLOCK_SPEED_STEP FX_PER_TICK(3.33, DODGE_TICK_MS)
+#define DODGE_PLAYER_SPEED FX_PER_TICK(26.67, DODGE_TICK_MS) // ~1.33 px/tick
+
+// Pausas na troca de fase: mensagem de fase concluída e início da próxima
+#define LEVEL_COMPLETE_PAUSE_MS 2000
+#define LEVEL_START_PAUSE_MS 500
 
 static const char *TAG = "game_system";
 
@@ -43,255 +84,347 @@ typedef struct {
     int y;
 } Position;
 
+// Bloco do Dodge: cai em frações de pixel
+typedef struct {
+    int x;
+    fx_t y;
+} DodgeBlock;
+
 // Estrutura para o jogo Dodge the Blocks
 typedef struct {
-    Position player;
-    Position blocks[10]; // Array de blocos
+    Position player;       // x é a parte inteira de player_x
+    fx_t player_x;
+    DodgeBlock blocks[10]; // Array de blocos
     int block_count;
-    int block_speed;
+    fx_t block_speed;      // por tick
     bool game_over;
     int score;
     int lives;
     int high_score;
+    Rng rng;
+    bool background_ready;
+    HudNumber hud_score;
+    HudNumber hud_lives;
 } DodgeGame;
 
+// Grade da cobrinha: células de 4x4 pixels
+#define SNAKE_CELL 4
+#define SNAKE_COLS (WIDTH / SNAKE_CELL)
+#define SNAKE_ROWS (HEIGHT / SNAKE_CELL)
+#define SNAKE_CELLS (SNAKE_COLS * SNAKE_ROWS) // potência de 2 (512)
+
 // Estrutura para o jogo da cobrinha
 typedef struct {
-    Position body[100];
+    uint16_t body[SNAKE_CELLS];              // anel de células (y * SNAKE_COLS + x), body[head] é a cabeça
+    int head;
     int length;
+    uint32_t occupied[SNAKE_CELLS / 32];     // bitmap das células ocupadas pelo corpo
     int direction;
     Position food;
     bool game_over;
     int score;
     int high_score;
+    Rng rng;
+    bool background_ready;
+    HudNumber hud_score;
 } SnakeGame;
 
 // Estrutura para o jogo Pong
 typedef struct {
-    Position ball;
-    Position ball_velocity;
+    FxVec ball;                  // centro da bola
+    FxVec ball_velocity;         // por tick
+    fx_t ball_speed;             // módulo de ball_velocity
     int paddle_pos;
     int paddle_width;
     bool game_over;
     int score;
     int high_score;
+    bool background_ready;
+    HudNumber hud_score;
 } PongGame;
 
 typedef struct {
     Position player;
-    Position foods[4]; // 4 comidas por nível
+    Position foods[MAZE_MAX_FOODS]; // até 4 comidas por nível
     int food_count;
-    Position walls[50]; // Array de paredes
-    int wall_count;
+    uint8_t wall_grid[BUFFER_SIZE]; // Paredes em bits, no layout do display_buffer
     int level;
+    int dx, dy;                  // passo pedido pela inclinação, dado no tick
     bool game_over;
     bool level_complete;
     int high_score;
+    bool background_ready;       // fundo com paredes e HUD do nível atual
 } TiltMazeGame;
 
-// Funções do buzzer
-void buzzer_init() {
-    ledc_timer_config_t timer_conf = {
-        .speed_mode = BUZZER_LEDC_MODE,
-        .duty_resolution = BUZZER_LEDC_DUTY_RES,
-        .timer_num = BUZZER_LEDC_TIMER,
-        .freq_hz = 2000,
-        .clk_cfg = LEDC_AUTO_CLK
-    };
-    ledc_timer_config(&timer_conf);
-
-    ledc_channel_config_t channel_conf = {
-        .gpio_num = BUZZER_PIN,
-        .speed_mode = BUZZER_LEDC_MODE,
-        .channel = BUZZER_LEDC_CHANNEL,
-        .timer_sel = BUZZER_LEDC_TIMER,
-        .duty = 0,
-        .hpoint = 0
-    };
-    ledc_channel_config(&channel_conf);
-}
-
-void buzzer_play_tone(int frequency, int duration_ms) {
-    ledc_set_freq(BUZZER_LEDC_MODE, BUZZER_LEDC_TIMER, frequency);
-    ledc_set_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL, 128); // 50% duty cycle
-    ledc_update_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL);
-    vTaskDelay(duration_ms / portTICK_PERIOD_MS);
-    ledc_set_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL, 0); // Desliga
-    ledc_update_duty(BUZZER_LEDC_MODE, BUZZER_LEDC_CHANNEL);
-}
-
-void play_game_over_sound() {
-    buzzer_play_tone(300, 200);
-    vTaskDelay(100 / portTICK_PERIOD_MS);
-    buzzer_play_tone(200, 300);
-    vTaskDelay(100 / portTICK_PERIOD_MS);
-    buzzer_play_tone(150, 400);
-}
+// Coluna onde começa o número de "<rótulo> <número>" desenhado em x
+#define HUD_AFTER(x, label) ((x) + (int)(sizeof(label) - 1) * HUD_CHAR_WIDTH)
+
+// Fundo de snake, pong e dodge: rótulos e o recorde, que não mudam durante
+// a partida
+static void draw_score_background(int high_score, int record_x, int record_y) {
+    char text[30];
 
-void play_new_record_sound() {
-    buzzer_play_tone(1000, 100);
-    vTaskDelay(50 / portTICK_PERIOD_MS);
-    buzzer_play_tone(1200, 100);
-    vTaskDelay(50 / portTICK_PERIOD_MS);
-    buzzer_play_tone(1500, 200);
+    clear_screen();
+    draw_text(0, 0, "Score:");
+    snprintf(text, sizeof(text), "Recorde: %d", high_score);
+    draw_text(record_x, record_y, text);
 }
 
 // Implementações dos jogos
-void snake_game_init(SnakeGame *game) {
+static inline bool snake_cell_occupied(const SnakeGame *game, int cell) {
+    return game->occupied[cell / 32] & (1u << (cell % 32));
+}
+
+static inline void snake_cell_set(SnakeGame *game, int cell, bool on) {
+    if (on) {
+        game->occupied[cell / 32] |= 1u << (cell % 32);
+    } else {
+        game->occupied[cell / 32] &= ~(1u << (cell % 32));
+    }
+}
+
+// Sorteia a comida entre as células livres. Retorna false se não sobrou
+// nenhuma (a cobra ocupa a tela inteira).
+static bool snake_spawn_food(SnakeGame *game) {
+    int free_cells = SNAKE_CELLS - game->length;
+    if (free_cells <= 0) return false;
+
+    int n = rng_below(&game->rng, free_cells);
+    for (int w = 0; w < SNAKE_CELLS / 32; w++) {
+        uint32_t free_bits = ~game->occupied[w];
+        int count = __builtin_popcount(free_bits);
+        if (n >= count) {
+            n -= count;
+            continue;
+        }
+        // n-ésimo bit livre dentro da palavra
+        while (n-- > 0) free_bits &= free_bits - 1;
+        int cell = w * 32 + __builtin_ctz(free_bits);
+        game->food.x = (cell % SNAKE_COLS) * SNAKE_CELL;
+        game->food.y = (cell / SNAKE_COLS) * SNAKE_CELL;
+        return true;
+    }
+    return false;
+}
+
+void snake_game_init(SnakeGame *game, uint32_t seed) {
+    rng_seed(&game->rng, seed);
     game->length = 3;
     game->direction = 1;
     game->game_over = false;
     game->score = 0;
-    game->high_score = read_high_score("snake");
+    game->high_score = scores_get("snake");
+    game->background_ready = false;
+    hud_number_init(&game->hud_score, HUD_AFTER(0, "Score: "), 0);
+    memset(game->occupied, 0, sizeof(game->occupied));
 
+    // Cabeça no centro, corpo para a esquerda; o anel guarda da cauda à cabeça
     for (int i = 0; i < game->length; i++) {
-        game->body[i].x = (WIDTH/2) - i * 4;
-        game->body[i].y = HEIGHT/2;
+        int cell = (SNAKE_ROWS / 2) * SNAKE_COLS + SNAKE_COLS / 2 - (game->length - 1 - i);
+        game->body[i] = cell;
+        snake_cell_set(game, cell, true);
     }
+    game->head = game->length - 1;
 
-    game->food.x = (rand() % (WIDTH / 4)) * 4;
-    game->food.y = (rand() % (HEIGHT / 4)) * 4;
+    snake_spawn_food(game);
 }
 
+// Move a cabeça uma célula: O(1) independente do tamanho da cobra
 void snake_game_update(SnakeGame *game) {
     if (game->game_over) return;
 
-    // Move o corpo
-    for (int i = game->length - 1; i > 0; i--) {
-        game->body[i] = game->body[i-1];
-    }
+    int head = game->body[game->head];
+    int x = head % SNAKE_COLS;
+    int y = head / SNAKE_COLS;
 
-    // Move a cabeça
     switch (game->direction) {
-        case 0: game->body[0].y -= 4; break;
-        case 1: game->body[0].x += 4; break;
-        case 2: game->body[0].y += 4; break;
-        case 3: game->body[0].x -= 4; break;
+        case 0: y--; break;
+        case 1: x++; break;
+        case 2: y++; break;
+        case 3: x--; break;
     }
 
-    // Verifica comida
-    if (game->body[0].x == game->food.x && game->body[0].y == game->food.y) {
-        game->length++;
-        game->score += 10;
-        game->food.x = (rand() % (WIDTH / 4)) * 4;
-        game->food.y = (rand() % (HEIGHT / 4)) * 4;
+    // Verifica colisões com as bordas
+    if (x < 0 || x >= SNAKE_COLS || y < 0 || y >= SNAKE_ROWS) {
+        game->game_over = true;
+        return;
+    }
+
+    int cell = y * SNAKE_COLS + x;
+    bool eating = (x * SNAKE_CELL == game->food.x && y * SNAKE_CELL == game->food.y);
+
+    // Sem comida a cauda anda junto (e libera a célula antes do teste, como
+    // antes: a cabeça pode entrar onde a cauda estava)
+    if (!eating) {
+        int tail = (game->head - game->length + 1) & (SNAKE_CELLS - 1);
+        snake_cell_set(game, game->body[tail], false);
     }
 
-    // Verifica colisões
-    if (game->body[0].x < 0 || game->body[0].x >= WIDTH ||
-        game->body[0].y < 0 || game->body[0].y >= HEIGHT) {
+    if (snake_cell_occupied(game, cell)) {
         game->game_over = true;
         return;
     }
 
-    for (int i = 1; i < game->length; i++) {
-        if (game->body[0].x == game->body[i].x && 
-            game->body[0].y == game->body[i].y) {
-            game->game_over = true;
-            return;
+    game->head = (game->head + 1) & (SNAKE_CELLS - 1);
+    game->body[game->head] = cell;
+    snake_cell_set(game, cell, true);
+
+    if (eating) {
+        game->length++;
+        game->score += 10;
+        if (!snake_spawn_food(game)) {
+            game->game_over = true; // tela cheia
         }
     }
 }
 
-void snake_game_render(SnakeGame *game) {
+// Vira a cobra para a direção da inclinação, sem meia-volta
+void snake_game_input(SnakeGame *game, const TiltInput *tilt) {
+    if (tilt->dir_x > 0 && game->direction != 3) {
+        game->direction = 1;
+    } else if (tilt->dir_x < 0 && game->direction != 1) {
+        game->direction = 3;
+    } else if (tilt->dir_y > 0 && game->direction != 0) {
+        game->direction = 2;
+    } else if (tilt->dir_y < 0 && game->direction != 2) {
+        game->direction = 0;
+    }
+}
+
+void snake_game_draw(SnakeGame *game) {
+    if (!game->background_ready) {
+        draw_score_background(game->high_score, WIDTH - 70, 0);
+        display_set_background();
+        game->background_ready = true;
+    }
     clear_screen();
+    draw_background();
     
     // Desenha a cobra
     for (int i = 0; i < game->length; i++) {
-        draw_rect(game->body[i].x, game->body[i].y, 4, 4, true);
+        int cell = game->body[(game->head - i) & (SNAKE_CELLS - 1)];
+        draw_rect((cell % SNAKE_COLS) * SNAKE_CELL, (cell / SNAKE_COLS) * SNAKE_CELL,
+                  SNAKE_CELL, SNAKE_CELL, true);
     }
     
     // Desenha a comida
     draw_rect(game->food.x, game->food.y, 4, 4, false);
     
-    // Desenha a pontuação e recorde
-    char score_text[30];
-    snprintf(score_text, sizeof(score_text), "Score: %d", game->score);
-    draw_text(0, 0, score_text);
-    
-    snprintf(score_text, sizeof(score_text), "Recorde: %d", game->high_score);
-    draw_text(WIDTH - 70, 0, score_text);
-    
-    update_display();
+    // Desenha a pontuação (rótulos e recorde estão no fundo)
+    draw_hud_number(&game->hud_score, game->score);
 }
 
 void pong_game_init(PongGame *game) {
-    game->ball.x = WIDTH / 2;
-    game->ball.y = HEIGHT / 2;
-    game->ball_velocity.x = 2;
-    game->ball_velocity.y = 2;
+    game->ball.x = FX_FROM_INT(WIDTH / 2);
+    game->ball.y = FX_FROM_INT(HEIGHT / 2);
+    game->ball_speed = PONG_BALL_SPEED;
+    game->ball_velocity = physics_direction_up(game->ball_speed, PONG_SERVE_ANGLE);
+    game->ball_velocity.y = -game->ball_velocity.y; // saque para baixo
     game->paddle_pos = WIDTH / 2;
     game->paddle_width = 20;
     game->game_over = false;
     game->score = 0;
-    game->high_score = read_high_score("pong");
+    game->high_score = scores_get("pong");
+    game->background_ready = false;
+    hud_number_init(&game->hud_score, HUD_AFTER(0, "Score: "), 0);
 }
 
 void pong_game_update(PongGame *game) {
     if (game->game_over) return;
 
     // Move a bola
-    game->ball.x += game->ball_velocity.x;
-    game->ball.y += game->ball_velocity.y;
+    FxVec from = game->ball;
+    FxVec to = { from.x + game->ball_velocity.x, from.y + game->ball_velocity.y };
 
-    // Colisão com as paredes laterais
-    if (game->ball.x <= 0 || game->ball.x >= WIDTH - 1) {
+    // Paredes laterais e superior: reflete o que passou da parede
+    if (to.x < 0) {
+        to.x = -to.x;
+        game->ball_velocity.x = -game->ball_velocity.x;
+    } else if (to.x > FX_FROM_INT(WIDTH - 1)) {
+        to.x = 2 * FX_FROM_INT(WIDTH - 1) - to.x;
         game->ball_velocity.x = -game->ball_velocity.x;
     }
-
-    // Colisão com a parede superior
-    if (game->ball.y <= 0) {
+    if (to.y < 0) {
+        to.y = -to.y;
         game->ball_velocity.y = -game->ball_velocity.y;
     }
 
-    // Colisão com a raquete
-    if (game->ball.y >= HEIGHT - 4 && 
-        game->ball.x >= game->paddle_pos - game->paddle_width/2 && 
-        game->ball.x <= game->paddle_pos + game->paddle_width/2) {
-        game->ball_velocity.y = -game->ball_velocity.y;
-        game->score += 5;
+    // Raquete: testa o trajeto do tick inteiro, não só onde a bola parou,
+    // para a bola rápida não atravessar. O ângulo de saída vai de 0 no
+    // centro a 60 graus na ponta, e a bola acelera um pouco a cada rebatida.
+    fx_t hit_x;
+    if (game->ball_velocity.y > 0 && physics_sweep_down(from, to, PONG_PADDLE_LINE, &hit_x)) {
+        fx_t offset = hit_x - FX_FROM_INT(game->paddle_pos);
+        fx_t half = FX_FROM_INT(game->paddle_width / 2);
+        if (offset >= -half && offset <= half) {
+            int angle = (int)((int64_t)offset * PHYSICS_ANGLE_STEPS / half);
+            game->ball_speed += PONG_BALL_SPEED_STEP;
+            if (game->ball_speed > PONG_BALL_SPEED_MAX) {
+                game->ball_speed = PONG_BALL_SPEED_MAX;
+            }
+            game->ball_velocity = physics_direction_up(game->ball_speed, angle);
+            to = (FxVec){ hit_x, PONG_PADDLE_LINE };
+            game->score += 5;
+        }
     }
+    game->ball = to;
 
     // Verifica se a bola passou da raquete
-    if (game->ball.y >= HEIGHT) {
+    if (game->ball.y >= FX_FROM_INT(HEIGHT)) {
         game->game_over = true;
     }
 }
 
-void pong_game_render(PongGame *game) {
+// Raquete proporcional ao ângulo: 90 graus deslocam 75 pixels do centro
+// (30 graus, ou 0.5 g, deslocam ~25 pixels)
+void pong_game_input(PongGame *game, const TiltInput *tilt) {
+    game->paddle_pos = (WIDTH/2 * Q15_ONE + tilt->x * 75) / Q15_ONE;
+    if (game->paddle_pos < game->paddle_width/2) {
+        game->paddle_pos = game->paddle_width/2;
+    }
+    if (game->paddle_pos > WIDTH - game->paddle_width/2) {
+        game->paddle_pos = WIDTH - game->paddle_width/2;
+    }
+}
+
+void pong_game_draw(PongGame *game) {
+    if (!game->background_ready) {
+        draw_score_background(game->high_score, WIDTH - 70, 0);
+        display_set_background();
+        game->background_ready = true;
+    }
     clear_screen();
+    draw_background();
     
     // Desenha a bola
-    draw_rect(game->ball.x - 1, game->ball.y - 1, 3, 3, true);
+    draw_rect(FX_TO_INT(game->ball.x) - 1, FX_TO_INT(game->ball.y) - 1, 3, 3, true);
     
     // Desenha a raquete
     draw_rect(game->paddle_pos - game->paddle_width/2, HEIGHT - 2, game->paddle_width, 2, true);
     
-    // Desenha a pontuação e recorde
-    char score_text[30];
-    snprintf(score_text, sizeof(score_text), "Score: %d", game->score);
-    draw_text(0, 0, score_text);
-    
-    snprintf(score_text, sizeof(score_text), "Recorde: %d", game->high_score);
-    draw_text(WIDTH - 70, 0, score_text);
-    
-    update_display();
+    // Desenha a pontuação (rótulos e recorde estão no fundo)
+    draw_hud_number(&game->hud_score, game->score);
 }
 
-void dodge_game_init(DodgeGame *game) {
+void dodge_game_init(DodgeGame *game, uint32_t seed) {
+    rng_seed(&game->rng, seed);
+    game->player_x = FX_FROM_INT(WIDTH / 2);
     game->player.x = WIDTH / 2;
     game->player.y = HEIGHT - 10;
     game->block_count = 3; // Começa com 3 blocos
-    game->block_speed = 2;
+    game->block_speed = DODGE_BLOCK_SPEED;
     game->game_over = false;
     game->score = 0;
     game->lives = 3;
-    game->high_score = read_high_score("dodge");
+    game->high_score = scores_get("dodge");
+    game->background_ready = false;
+    hud_number_init(&game->hud_score, HUD_AFTER(0, "Score: "), 0);
+    hud_number_init(&game->hud_lives, HUD_AFTER(WIDTH - 40, "Vidas: "), 0);
     
     // Posiciona os blocos aleatoriamente no topo
     for (int i = 0; i < game->block_count; i++) {
-        game->blocks[i].x = rand() % (WIDTH - 10);
-        game->blocks[i].y = -10 - (i * 30); // Espaçamento vertical
+        game->blocks[i].x = rng_below(&game->rng, WIDTH - 10);
+        game->blocks[i].y = FX_FROM_INT(-10 - (i * 30)); // Espaçamento vertical
     }
 }
 
@@ -300,11 +433,14 @@ void dodge_game_update(DodgeGame *game) {
     
     // Move os blocos para baixo
     for (int i = 0; i < game->block_count; i++) {
+        int top = FX_TO_INT(game->blocks[i].y);
         game->blocks[i].y += game->block_speed;
+        int y = FX_TO_INT(game->blocks[i].y);
         
-        // Verifica colisão com o jogador
-        if (game->blocks[i].y + 8 >= game->player.y && 
-            game->blocks[i].y <= game->player.y + 8 &&
+        // Verifica colisão com o jogador ao longo da queda do tick (de top
+        // até y), para um bloco rápido não passar por cima dele
+        if (y + 8 >= game->player.y && 
+            top <= game->player.y + 8 &&
             game->blocks[i].x + 10 >= game->player.x && 
             game->blocks[i].x <= game->player.x + 10) {
             
@@ -314,20 +450,23 @@ void dodge_game_update(DodgeGame *game) {
                 return;
             }
             // Reposiciona o bloco
-            game->blocks[i].x = rand() % (WIDTH - 10);
-            game->blocks[i].y = -10;
+            game->blocks[i].x = rng_below(&game->rng, WIDTH - 10);
+            game->blocks[i].y = FX_FROM_INT(-10);
         }
         
         // Reposiciona blocos que saíram da tela
-        if (game->blocks[i].y > HEIGHT) {
-            game->blocks[i].x = rand() % (WIDTH - 10);
-            game->blocks[i].y = -10;
+        if (game->blocks[i].y > FX_FROM_INT(HEIGHT)) {
+            game->blocks[i].x = rng_below(&game->rng, WIDTH - 10);
+            game->blocks[i].y = FX_FROM_INT(-10);
             game->score++;
             
             // Aumenta a dificuldade a cada 10 pontos
             if (game->score % 10 == 0) {
-                game->block_speed++;
+                game->block_speed += DODGE_BLOCK_SPEED_STEP;
                 if (game->block_count < 10) {
+                    // O bloco novo entra pelo topo (antes ele herdava lixo da pilha)
+                    game->blocks[game->block_count].x = rng_below(&game->rng, WIDTH - 10);
+                    game->blocks[game->block_count].y = FX_FROM_INT(-10);
                     game->block_count++;
                 }
             }
@@ -335,155 +474,102 @@ void dodge_game_update(DodgeGame *game) {
     }
 }
 
-void dodge_game_render(DodgeGame *game) {
+// Até DODGE_PLAYER_SPEED por tick com 90 graus de inclinação
+void dodge_game_input(DodgeGame *game, const TiltInput *tilt) {
+    game->player_x += tilt->x * DODGE_PLAYER_SPEED / Q15_ONE;
+    
+    if (game->player_x < 0) game->player_x = 0;
+    if (game->player_x > FX_FROM_INT(WIDTH - 10)) game->player_x = FX_FROM_INT(WIDTH - 10);
+    game->player.x = FX_TO_INT(game->player_x);
+}
+
+void dodge_game_draw(DodgeGame *game) {
+    if (!game->background_ready) {
+        draw_score_background(game->high_score, 0, 10);
+        draw_text(WIDTH - 40, 0, "Vidas:");
+        display_set_background();
+        game->background_ready = true;
+    }
     clear_screen();
+    draw_background();
     
     // Desenha o jogador (um quadrado)
     draw_rect(game->player.x, game->player.y, 10, 8, true);
     
     // Desenha os blocos
     for (int i = 0; i < game->block_count; i++) {
-        draw_rect(game->blocks[i].x, game->blocks[i].y, 10, 8, false);
+        draw_rect(game->blocks[i].x, FX_TO_INT(game->blocks[i].y), 10, 8, false);
     }
     
-    // Desenha a pontuação e vidas
-    char score_text[40];
-    snprintf(score_text, sizeof(score_text), "Score: %d", game->score);
-    draw_text(0, 0, score_text);
-    
-    snprintf(score_text, sizeof(score_text), "Vidas: %d", game->lives);
-    draw_text(WIDTH - 40, 0, score_text);
-    
-    snprintf(score_text, sizeof(score_text), "Recorde: %d", game->high_score);
-    draw_text(0, 10, score_text);
-    
-    update_display();
+    // Desenha a pontuação e vidas (rótulos e recorde estão no fundo)
+    draw_hud_number(&game->hud_score, game->score);
+    draw_hud_number(&game->hud_lives, game->lives);
 }
 
+// Carrega o nível da tabela em flash (ou do cartão SD, se houver um arquivo
+// para ele) direto no grid de paredes
 void tilt_maze_init_level(TiltMazeGame *game, int level) {
+    MazeLevelInfo info;
+
     game->level = level;
-    game->food_count = 4;
     game->level_complete = false;
-    
-    // Limpa paredes
-    game->wall_count = 0;
-    
-    // Posição inicial do jogador (depende do nível)
-    game->player.x = 10;
-    game->player.y = 10;
-    
-    // Configuração dos níveis
-    switch(level) {
-        case 1:
-            // Nível 1 - layout simples
-            game->foods[0] = (Position){30, 10};
-            game->foods[1] = (Position){90, 10};
-            game->foods[2] = (Position){30, 50};
-            game->foods[3] = (Position){90, 50};
-            
-            // Paredes
-            game->walls[game->wall_count++] = (Position){60, 20};
-            game->walls[game->wall_count++] = (Position){60, 30};
-            game->walls[game->wall_count++] = (Position){60, 40};
-            break;
-            
-        case 2:
-            // Nível 2 - mais paredes
-            game->foods[0] = (Position){20, 20};
-            game->foods[1] = (Position){100, 20};
-            game->foods[2] = (Position){20, 40};
-            game->foods[3] = (Position){100, 40};
-            
-            // Paredes em forma de cruz
-            for(int i=20; i<40; i++) {
-                game->walls[game->wall_count++] = (Position){60, i};
-            }
-            for(int i=40; i<80; i++) {
-                game->walls[game->wall_count++] = (Position){i, 30};
-            }
-            break;
-            
-        case 3:
-            // Nível 3 - labirinto mais complexo
-            game->foods[0] = (Position){10, 50};
-            game->foods[1] = (Position){110, 10};
-            game->foods[2] = (Position){110, 50};
-            game->foods[3] = (Position){10, 10};
-            
-            // Paredes
-            for(int i=10; i<60; i++) {
-                if(i != 30) game->walls[game->wall_count++] = (Position){40, i};
-            }
-            for(int i=40; i<90; i++) {
-                if(i != 60) game->walls[game->wall_count++] = (Position){i, 30};
-            }
-            for(int i=30; i<60; i++) {
-                game->walls[game->wall_count++] = (Position){80, i};
-            }
-            break;
-            
-        case 4:
-            // Nível 4 - corredores
-            game->foods[0] = (Position){10, 10};
-            game->foods[1] = (Position){110, 10};
-            game->foods[2] = (Position){10, 50};
-            game->foods[3] = (Position){110, 50};
-            
-            // Paredes em zigue-zague
-            for(int i=0; i<5; i++) {
-                int y = 15 + i*8;
-                game->walls[game->wall_count++] = (Position){20, y};
-                game->walls[game->wall_count++] = (Position){40, y+4};
-                game->walls[game->wall_count++] = (Position){60, y};
-                game->walls[game->wall_count++] = (Position){80, y+4};
-                game->walls[game->wall_count++] = (Position){100, y};
-            }
-            break;
-            
-        case 5:
-            // Nível 5 - desafio final
-            game->foods[0] = (Position){5, 5};
-            game->foods[1] = (Position){115, 5};
-            game->foods[2] = (Position){5, 55};
-            game->foods[3] = (Position){115, 55};
-            
-            // Paredes formando um labirinto
-            for(int i=10; i<60; i++) {
-                game->walls[game->wall_count++] = (Position){20, i};
-                if(i < 30 || i > 40) game->walls[game->wall_count++] = (Position){60, i};
-            }
-            for(int i=20; i<110; i++) {
-                if(i < 50 || i > 70) game->walls[game->wall_count++] = (Position){i, 30};
-            }
-            for(int i=30; i<60; i++) {
-                game->walls[game->wall_count++] = (Position){90, i};
-            }
-            break;
+    game->background_ready = false;
+
+    if (!maze_level_load(level, &info, game->wall_grid)) {
+        ESP_LOGE(TAG, "Falha ao carregar o nível %d", level);
+        memset(game->wall_grid, 0, sizeof(game->wall_grid));
+        info = (MazeLevelInfo){ .spawn = {10, 10}, .food_count = 1, .foods = {{WIDTH - 10, HEIGHT - 10}} };
+    }
+
+    game->player.x = info.spawn.x;
+    game->player.y = info.spawn.y;
+    game->food_count = info.food_count;
+    for (int i = 0; i < MAZE_MAX_FOODS; i++) {
+        if (i < info.food_count) {
+            game->foods[i] = (Position){info.foods[i].x, info.foods[i].y};
+        } else {
+            game->foods[i] = (Position){-10, -10};
+        }
     }
 }
 
 void tilt_maze_init(TiltMazeGame *game) {
     game->game_over = false;
     game->level = 0;
-    game->high_score = read_high_score("tilt_maze");
+    game->dx = 0;
+    game->dy = 0;
+    game->high_score = scores_get("tilt_maze");
     tilt_maze_init_level(game, 1); // Começa no nível 1
 }
 
+// O jogador (4x4 em x, y) encosta em alguma parede? Lê no máximo duas
+// páginas de 4 colunas do grid, independente do tamanho do labirinto.
 bool is_wall(TiltMazeGame *game, int x, int y) {
-    for(int i=0; i<game->wall_count; i++) {
-        if(game->walls[i].x == x && game->walls[i].y == y) {
-            return true;
+    int page = y / 8;
+    uint16_t rows = 0x0F << (y % 8);
+
+    for (int i = x; i < x + 4 && i < WIDTH; i++) {
+        uint16_t column = game->wall_grid[page * WIDTH + i];
+        if (page + 1 < PAGES) {
+            column |= game->wall_grid[(page + 1) * WIDTH + i] << 8;
         }
+        if (column & rows) return true;
     }
     return false;
 }
 
-void tilt_maze_update(TiltMazeGame *game, int dx, int dy) {
+// Um passo na direção da inclinação (eixo dominante)
+void tilt_maze_input(TiltMazeGame *game, const TiltInput *tilt) {
+    game->dx = tilt->dir_x;
+    game->dy = tilt->dir_y;
+}
+
+void tilt_maze_update(TiltMazeGame *game) {
     if(game->game_over || game->level_complete) return;
     
     // Calcula nova posição
-    int new_x = game->player.x + dx;
-    int new_y = game->player.y + dy;
+    int new_x = game->player.x + game->dx;
+    int new_y = game->player.y + game->dy;
     
     // Verifica limites da tela
     if(new_x < 0 || new_x >= WIDTH || new_y < 0 || new_y >= HEIGHT) {
@@ -508,36 +594,39 @@ void tilt_maze_update(TiltMazeGame *game, int dx, int dy) {
             game->foods[i].y = -10;
             game->food_count--;
             
-            // Toca som de coleta
-            buzzer_play_tone(800, 50);
+            // Toca som de coleta (entra na fila, o tick não espera)
+            buzzer_play(&melody_food);
             
             if(game->food_count == 0) {
                 game->level_complete = true;
                 // Toca som de nível completo
-                buzzer_play_tone(1000, 100);
-                vTaskDelay(50 / portTICK_PERIOD_MS);
-                buzzer_play_tone(1200, 150);
+                buzzer_play(&melody_level_complete);
             }
             break;
         }
     }
 }
 
-void tilt_maze_render(TiltMazeGame *game) {
-    clear_screen();
-    
-    // Desenha o nível atual e recorde
+// Nível, recorde e paredes só mudam na troca de nível
+static void tilt_maze_build_background(TiltMazeGame *game) {
     char level_text[40];
+
+    clear_screen();
     snprintf(level_text, sizeof(level_text), "Nivel: %d", game->level);
     draw_text(0, 0, level_text);
     
     snprintf(level_text, sizeof(level_text), "Recorde: %d", game->high_score);
     draw_text(WIDTH - 70, 0, level_text);
     
-    // Desenha paredes
-    for(int i=0; i<game->wall_count; i++) {
-        draw_rect(game->walls[i].x, game->walls[i].y, 4, 4, true);
-    }
+    draw_layer(game->wall_grid);
+    display_set_background();
+    game->background_ready = true;
+}
+
+void tilt_maze_draw(TiltMazeGame *game) {
+    if (!game->background_ready) tilt_maze_build_background(game);
+    clear_screen();
+    draw_background();
     
     // Desenha comidas
     for(int i=0; i<4; i++) {
@@ -553,22 +642,153 @@ void tilt_maze_render(TiltMazeGame *game) {
     if(game->level_complete) {
         draw_text(WIDTH/2 - 30, HEIGHT/2 - 10, "Nivel Completo!");
     }
-    
-    update_display();
 }
 
+// Próximo nível ou, depois do último, fim da partida
+void tilt_maze_next_level(TiltMazeGame *game) {
+    if (game->level < maze_level_count()) {
+        tilt_maze_init_level(game, game->level + 1);
+    } else {
+        game->game_over = true;
+    }
+}
+
+// Adaptadores dos jogos para a interface comum (game.h)
+static void game_snake_init(void *s, uint32_t seed) { snake_game_init(s, seed); }
+static void game_snake_input(void *s, const TiltInput *tilt) { snake_game_input(s, tilt); }
+static void game_snake_update(void *s) { snake_game_update(s); }
+static void game_snake_draw(void *s) { snake_game_draw(s); }
+static bool game_snake_over(const void *s) { return ((const SnakeGame *)s)->game_over; }
+static int game_snake_score(const void *s) { return ((const SnakeGame *)s)->score; }
+
+static void game_pong_init(void *s, uint32_t seed) { (void)seed; pong_game_init(s); }
+static void game_pong_input(void *s, const TiltInput *tilt) { pong_game_input(s, tilt); }
+static void game_pong_update(void *s) { pong_game_update(s); }
+static void game_pong_draw(void *s) { pong_game_draw(s); }
+static bool game_pong_over(const void *s) { return ((const PongGame *)s)->game_over; }
+static int game_pong_score(const void *s) { return ((const PongGame *)s)->score; }
+
+static void game_dodge_init(void *s, uint32_t seed) { dodge_game_init(s, seed); }
+static void game_dodge_input(void *s, const TiltInput *tilt) { dodge_game_input(s, tilt); }
+static void game_dodge_update(void *s) { dodge_game_update(s); }
+static void game_dodge_draw(void *s) { dodge_game_draw(s); }
+static bool game_dodge_over(const void *s) { return ((const DodgeGame *)s)->game_over; }
+static int game_dodge_score(const void *s) { return ((const DodgeGame *)s)->score; }
+
+static void game_tilt_init(void *s, uint32_t seed) { (void)seed; tilt_maze_init(s); }
+static void game_tilt_input(void *s, const TiltInput *tilt) { tilt_maze_input(s, tilt); }
+static void game_tilt_update(void *s) { tilt_maze_update(s); }
+static void game_tilt_draw(void *s) { tilt_maze_draw(s); }
+static bool game_tilt_over(const void *s) { return ((const TiltMazeGame *)s)->game_over; }
+static int game_tilt_score(const void *s) { return ((const TiltMazeGame *)s)->level * 100; }
+static bool game_tilt_level_complete(const void *s) { return ((const TiltMazeGame *)s)->level_complete; }
+static void game_tilt_next_level(void *s) { tilt_maze_next_level(s); }
+
+// Registro dos jogos, na ordem do menu
+static const Game games[GAME_COUNT] = {
+    [GAME_SNAKE] = {
+        "snake", "Snake", "Game Over", &melody_game_over, sizeof(SnakeGame),
+        SNAKE_TICK_MS, SNAKE_FRAME_MS,
+        game_snake_init, game_snake_input, game_snake_update, game_snake_draw,
+        game_snake_over, game_snake_score, NULL, NULL },
+    [GAME_PONG] = {
+        "pong", "Pong", "Game Over", &melody_game_over, sizeof(PongGame),
+        PONG_TICK_MS, PONG_FRAME_MS,
+        game_pong_init, game_pong_input, game_pong_update, game_pong_draw,
+        game_pong_over, game_pong_score, NULL, NULL },
+    [GAME_DODGE] = {
+        "dodge", "Dodge Blocks", "Game Over", &melody_game_over, sizeof(DodgeGame),
+        DODGE_TICK_MS, DODGE_FRAME_MS,
+        game_dodge_init, game_dodge_input, game_dodge_update, game_dodge_draw,
+        game_dodge_over, game_dodge_score, NULL, NULL },
+    [GAME_TILT_MAZE] = {
+        "tilt_maze", "Tilt Maze", "Voce venceu!", &melody_new_record, sizeof(TiltMazeGame),
+        TILT_MAZE_TICK_MS, TILT_MAZE_FRAME_MS,
+        game_tilt_init, game_tilt_input, game_tilt_update, game_tilt_draw,
+        game_tilt_over, game_tilt_score, game_tilt_level_complete, game_tilt_next_level },
+};
+
+// Estado da partida em andamento: cabe qualquer um dos jogos
+typedef union {
+    SnakeGame snake;
+    PongGame pong;
+    DodgeGame dodge;
+    TiltMazeGame tilt_maze;
+} GameState;
+
+// Arena da sessão de jogo, do tamanho do maior estado: a partida escolhida
+// é alocada nela ao começar e a arena é zerada ao sair
+static GameState game_arena_buffer __attribute__((aligned(ARENA_ALIGN)));
+static Arena game_arena = { (uint8_t *)&game_arena_buffer, sizeof(game_arena_buffer), 0, 0 };
+
+// Desenha o quadro no buffer e entrega à tarefa de envio
+static void game_render(const Game *game, void *state) {
+    game->draw(state);
+    PROFILE_HUD();
+    display_present();
+}
+
+#if BENCHMARK_MODE
+void run_game_benchmarks(int ticks, BenchInputFn input) {
+    BenchResult results[GAME_COUNT];
+    for (int i = 0; i < GAME_COUNT; i++) {
+        benchmark_run(&games[i], ticks, input, &results[i]);
+    }
+    benchmark_report(results, GAME_COUNT);
+    benchmark_tilt_pipeline(BENCHMARK_TILT_SAMPLES);
+    benchmark_rng(BENCHMARK_RNG_SAMPLES);
+    benchmark_draw(BENCHMARK_DRAW_CALLS);
+}
+
+// Repete a última partida gravada de cada jogo, se houver (corpus do
+// benchmark e diagnóstico de picos de tempo de quadro vindos do campo)
+int run_replay_benchmarks(const char *const *paths, int count) {
+    BenchResult results[GAME_COUNT];
+    int played = 0, diverged = 0;
+
+    for (int i = 0; i < count && played < GAME_COUNT; i++) {
+        ReplayReader replay;
+        if (!replay_reader_open(&replay, paths[i])) continue;
+        if (replay.header.game < GAME_COUNT) {
+            if (!benchmark_replay(&games[replay.header.game], &replay, &results[played])) {
+                diverged++;
+            }
+            played++;
+        }
+        replay_reader_close(&replay);
+    }
+    if (played > 0) {
+        benchmark_report(results, played);
+    }
+    return diverged;
+}
+
+static void benchmark_task(void *pvParameters) {
+    char paths[GAME_COUNT][160];
+    const char *path_list[GAME_COUNT];
+
+    run_game_benchmarks(BENCHMARK_TICKS, benchmark_synthetic_input);
+    for (int i = 0; i < GAME_COUNT; i++) {
+        replay_path(paths[i], sizeof(paths[i]), games[i].name);
+        path_list[i] = paths[i];
+    }
+    run_replay_benchmarks(path_list, GAME_COUNT);
+    vTaskDelete(NULL);
+}
+#endif // BENCHMARK_MODE
+
 // Mostra o menu de seleção de jogos
 void show_menu(GameSelection selection) {
     clear_screen();
     
-    // Título
+    // Título e dica do ranking (aperto longo em NAV)
+    draw_text(10, 0, "NAV longo: ranking");
     draw_text(20, 10, "Selecione o Jogo");
     
     // Opções
-    draw_text(30, 25, "Snake");
-    draw_text(30, 35, "Pong");
-    draw_text(30, 45, "Dodge Blocks");
-    draw_text(30, 55, "Tilt Maze");
+    for (int i = 0; i < GAME_COUNT; i++) {
+        draw_text(30, 25 + i * 10, games[i].title);
+    }
     
     // Indicador de seleção (seta)
     draw_text(15, 25 + (selection * 10), ">");
@@ -576,283 +796,245 @@ void show_menu(GameSelection selection) {
     update_display();
 }
 
-// Mostra tela de Game Over e espera por qualquer botão
-void show_game_over_screen(int score, int high_score, bool new_record) {
+// Espera um aperto novo: descarta o que foi apertado antes (durante a
+// partida, por exemplo) e bloqueia na fila de botões. Ocioso por
+// POWER_IDLE_TIMEOUT_MS, dorme; a tela volta como estava (a RAM do display é
+// mantida) e o aperto que acordou não conta.
+ButtonId wait_button_press() {
+    ButtonId button;
+
+    buttons_flush();
+    while (!buttons_wait_press(&button, pdMS_TO_TICKS(POWER_IDLE_TIMEOUT_MS))) {
+        power_idle_sleep();
+    }
+    return button;
+}
+
+// Ranking do jogo (top 10 em duas colunas) e estatísticas, direto da RAM;
+// espera qualquer botão
+void show_leaderboard_screen(const char *game_name, const char *title) {
+    GameScores board;
+    char text[32];
+
+    scores_get_board(game_name, &board);
+
+    clear_screen();
+    snprintf(text, sizeof(text), "Ranking %s", title);
+    draw_text(0, 0, text);
+
+    for (int i = 0; i < SCORES_TOP_N; i++) {
+        int x = (i < SCORES_TOP_N / 2) ? 0 : WIDTH / 2;
+        int y = 10 + (i % (SCORES_TOP_N / 2)) * 8;
+        if (i < board.top_count) {
+            snprintf(text, sizeof(text), "%d. %ld", i + 1, (long)board.top[i]);
+        } else {
+            snprintf(text, sizeof(text), "%d. -", i + 1);
+        }
+        draw_text(x, y, text);
+    }
+
+    int average = board.games_played ? (int)(board.score_sum / board.games_played) : 0;
+    // Em duas colunas, como o top 10: numa linha só não cabe com números
+    // de 3 dígitos
+    snprintf(text, sizeof(text), "Jogos:%u", (unsigned)board.games_played);
+    draw_text(0, 50, text);
+    snprintf(text, sizeof(text), "Media:%d", average);
+    draw_text(WIDTH / 2, 50, text);
+    snprintf(text, sizeof(text), "Mais longa: %us", (unsigned)(board.longest_run_ms / 1000));
+    draw_text(0, 57, text);
+    update_display();
+
+    wait_button_press();
+}
+
+// Mostra a tela de fim de partida e espera um botão: SELECT volta ao menu,
+// NAVIGATE mostra o ranking antes
+void show_game_over_screen(const Game *game, int score, int high_score, bool new_record) {
     char score_text[30];
     
     if (new_record) {
-        play_new_record_sound();
+        buzzer_play(&melody_new_record);
     } else {
-        play_game_over_sound();
+        buzzer_play(game->end_melody);
     }
     
-    while(1) {
-        clear_screen();
-        
-        draw_text(WIDTH/2 - 30, 15, "Game Over");
-        
-        snprintf(score_text, sizeof(score_text), "Pontuacao: %d", score);
-        draw_text(WIDTH/2 - 30, 30, score_text);
-        
-        snprintf(score_text, sizeof(score_text), "Recorde: %d", high_score);
-        draw_text(WIDTH/2 - 30, 40, score_text);
+    clear_screen();
+    
+    draw_text(WIDTH/2 - 30, 15, game->end_text);
+    
+    snprintf(score_text, sizeof(score_text), "Pontuacao: %d", score);
+    draw_text(WIDTH/2 - 30, 30, score_text);
+    
+    snprintf(score_text, sizeof(score_text), "Recorde: %d", high_score);
+    draw_text(WIDTH/2 - 30, 40, score_text);
+    
+    if (new_record) {
+        draw_text(WIDTH/2 - 40, 50, "Novo Recorde!");
+    } else {
+        draw_text(WIDTH/2 - 60, 55, "SEL:menu NAV:ranking");
+    }
+    
+    update_display();
+    
+    if (wait_button_press() == BUTTON_NAVIGATE) {
+        show_leaderboard_screen(game->name, game->title);
+    }
+}
+
+// Offsets do sensor: carrega do cartão ou, sem arquivo (ou com SELECT
+// pressionado no boot), mede com o aparelho parado e salva
+void calibrate_sensor() {
+    if (!button_is_down(BUTTON_SELECT) && sensor_load_calibration()) {
+        return;
+    }
+
+    clear_screen();
+    draw_text(WIDTH/2 - 36, 20, "Calibrando...");
+    draw_text(WIDTH/2 - 48, 35, "Deixe o aparelho");
+    draw_text(WIDTH/2 - 42, 45, "parado e plano");
+    update_display();
+
+    if (!sensor_calibrate()) {
+        ESP_LOGE(TAG, "Calibração falhou, usando o sensor sem offsets");
+        return;
+    }
+    sensor_save_calibration();
+}
+
+// Gravação da partida em andamento: a semente do gerador do jogo é sorteada
+// aqui, vai para o *_init e para o cabeçalho junto com a entrada de cada tick
+static ReplayWriter replay_writer;
+
+uint32_t start_recording(GameSelection game, const char *game_name, uint16_t tick_ms) {
+    char path[160];
+    uint32_t seed = esp_random();
+
+    replay_path(path, sizeof(path), game_name);
+    replay_writer_open(&replay_writer, path, game, seed, tick_ms);
+    return seed;
+}
+
+// Partida de qualquer jogo do registro: leitura do sensor por quadro, ticks
+// de simulação no ritmo do escalonador (gravados para o replay) e render
+// quando há quadro; no fim, recorde e tela final
+void play_game(GameSelection selection) {
+    const Game *game = &games[selection];
+    void *state = arena_alloc(&game_arena, game->state_size);
+    if (state == NULL) {
+        ESP_LOGE(TAG, "Estado de %s (%u bytes) não cabe na arena (%u bytes)",
+                 game->name, (unsigned)game->state_size, (unsigned)game_arena.size);
+        return;
+    }
+    
+    uint32_t seed = start_recording(selection, game->name, game->tick_ms);
+    game->init(state, seed);
+    TickType_t started = xTaskGetTickCount();
+    
+    TiltSample tilt = { 0 };
+    sensor_reset();
+    
+    FrameScheduler sched;
+    frame_scheduler_init(&sched, game->tick_ms, game->frame_ms);
+    
+    while (!game->game_over(state)) {
+        PROFILE_BEGIN(PROF_FRAME);
+        PROFILE_BEGIN(PROF_INPUT);
+        sensor_read(&tilt);
+        PROFILE_END(PROF_INPUT);
         
-        if (new_record) {
-            draw_text(WIDTH/2 - 40, 50, "Novo Recorde!");
-        } else {
-            draw_text(WIDTH/2 - 50, 55, "Pressione qualquer");
-            draw_text(WIDTH/2 - 40, 65, "botao para voltar");
+        // A entrada só é aplicada no tick: na cobrinha, duas viradas entre
+        // ticks poderiam inverter a cobra sobre si mesma
+        bool level_complete = false;
+        int ticks = frame_scheduler_begin(&sched);
+        for (int t = 0; t < ticks && !level_complete && !game->game_over(state); t++) {
+            game->input(state, &tilt.input);
+            replay_writer_tick(&replay_writer, &tilt.input);
+            
+            PROFILE_BEGIN(PROF_UPDATE);
+            game->update(state);
+            PROFILE_END(PROF_UPDATE);
+            level_complete = game_level_complete(game, state);
         }
         
-        update_display();
+        // A mensagem de fase concluída sempre aparece antes da pausa
+        if (frame_scheduler_should_render(&sched) || level_complete) {
+            PROFILE_BEGIN(PROF_RENDER);
+            game_render(game, state);
+            PROFILE_END(PROF_RENDER);
+        }
+        PROFILE_END(PROF_FRAME);
+        PROFILE_FRAME_END();
         
-        if (gpio_get_level(SELECT_BUTTON) || gpio_get_level(NAVIGATE_BUTTON)) {
-            while (gpio_get_level(SELECT_BUTTON) || gpio_get_level(NAVIGATE_BUTTON)) {
-                vTaskDelay(100 / portTICK_PERIOD_MS);
+        if (level_complete) {
+            vTaskDelay(LEVEL_COMPLETE_PAUSE_MS / portTICK_PERIOD_MS);
+            game->next_level(state);
+            if (!game->game_over(state)) {
+                vTaskDelay(LEVEL_START_PAUSE_MS / portTICK_PERIOD_MS);
+                frame_scheduler_reset(&sched);
             }
-            break;
         }
         
-        vTaskDelay(100 / portTICK_PERIOD_MS);
+        frame_scheduler_end(&sched);
+    }
+    
+    int score = game->score(state);
+    uint32_t duration_ms = (xTaskGetTickCount() - started) * portTICK_PERIOD_MS;
+    replay_writer_close(&replay_writer, score);
+    bool new_record = scores_submit(game->name, score, duration_ms);
+    arena_reset(&game_arena);
+    
+    show_game_over_screen(game, score, scores_get(game->name), new_record);
+}
+
+// Quanto da pilha do game_task nunca foi usado (marca d'água do FreeRTOS)
+static void report_stack_usage() {
+    UBaseType_t unused = uxTaskGetStackHighWaterMark(NULL);
+    
+    if (unused < GAME_TASK_STACK_MARGIN) {
+        ESP_LOGW(TAG, "Pilha do game_task quase cheia: %u de %d bytes livres",
+                 (unsigned)unused, GAME_TASK_STACK_SIZE);
+    } else {
+        ESP_LOGI(TAG, "Pilha do game_task: %u de %d bytes nunca usados, arena %u/%u bytes",
+                 (unsigned)unused, GAME_TASK_STACK_SIZE,
+                 (unsigned)game_arena.peak, (unsigned)game_arena.size);
     }
 }
 
 // Tarefa principal do sistema de jogos
 void game_task(void *pvParameters) {
-    gpio_set_direction(SELECT_BUTTON, GPIO_MODE_INPUT);
-    gpio_set_direction(NAVIGATE_BUTTON, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(SELECT_BUTTON, GPIO_PULLDOWN_ONLY);
-    gpio_set_pull_mode(NAVIGATE_BUTTON, GPIO_PULLDOWN_ONLY);
-
     GameSelection current_selection = GAME_SNAKE;
-    bool in_menu = true;
+    bool redraw = true;
 
     while (1) {
-        if (in_menu) {
+        // Só redesenha quando a seleção muda; entre um aperto e outro a
+        // tarefa fica bloqueada na fila de botões
+        if (redraw) {
             show_menu(current_selection);
-            
-            if (gpio_get_level(NAVIGATE_BUTTON)) {
+            redraw = false;
+        }
+        
+        ButtonId button;
+        if (!buttons_wait_press(&button, pdMS_TO_TICKS(POWER_IDLE_TIMEOUT_MS))) {
+            power_idle_sleep(); // o menu continua no display ao acordar
+            continue;
+        }
+        
+        // NAVIGATE curto passa para o próximo jogo (ao soltar); segurado,
+        // abre o ranking do jogo selecionado
+        if (button == BUTTON_NAVIGATE) {
+            if (buttons_held(BUTTON_NAVIGATE, BUTTONS_LONG_PRESS_MS)) {
+                const Game *game = &games[current_selection];
+                show_leaderboard_screen(game->name, game->title);
+            } else {
                 current_selection = (current_selection + 1) % GAME_COUNT;
-                vTaskDelay(200 / portTICK_PERIOD_MS);
             }
-            
-            if (gpio_get_level(SELECT_BUTTON)) {
-                in_menu = false;
-                vTaskDelay(200 / portTICK_PERIOD_MS);
-                
-                if (current_selection == GAME_SNAKE) {
-                    SnakeGame snake_game;
-                    snake_game_init(&snake_game);
-                    
-                    int16_t ax, ay, az;
-                    float filtered_ax = 0, filtered_ay = 0;
-                    const float alpha = 0.2;
-                    const float threshold = 0.3;
-                    
-                    while (!snake_game.game_over) {
-                        mpu6050_read_accel(&ax, &ay, &az);
-                        float gx = ax / 16384.0;
-                        float gy = ay / 16384.0;
-                        filtered_ax = low_pass_filter(gx, filtered_ax, alpha);
-                        filtered_ay = low_pass_filter(gy, filtered_ay, alpha);
-                        
-                        if (fabsf(filtered_ax) > fabsf(filtered_ay)) {
-                            if (filtered_ax > threshold && snake_game.direction != 3) {
-                                snake_game.direction = 1;
-                            } else if (filtered_ax < -threshold && snake_game.direction != 1) {
-                                snake_game.direction = 3;
-                            }
-                        } else {
-                            if (filtered_ay > threshold && snake_game.direction != 0) {
-                                snake_game.direction = 2;
-                            } else if (filtered_ay < -threshold && snake_game.direction != 2) {
-                                snake_game.direction = 0;
-                            }
-                        }
-                        
-                        snake_game_update(&snake_game);
-                        snake_game_render(&snake_game);
-                        vTaskDelay(GAME_SPEED / portTICK_PERIOD_MS);
-                    }
-                    
-                    bool new_record = false;
-                    int current_high_score = read_high_score("snake");
-                    if (snake_game.score > current_high_score) {
-                        new_record = true;
-                        write_high_score("snake", snake_game.score);
-                        current_high_score = snake_game.score;
-                    }
-                    
-                    show_game_over_screen(snake_game.score, current_high_score, new_record);
-                    
-                } else if (current_selection == GAME_PONG) {
-                    PongGame pong_game;
-                    pong_game_init(&pong_game);
-                    
-                    int16_t ax, ay, az;
-                    float filtered_ax = 0;
-                    const float alpha = 0.2;
-                    
-                    while (!pong_game.game_over) {
-                        mpu6050_read_accel(&ax, &ay, &az);
-                        float gx = ax / 16384.0;
-                        filtered_ax = low_pass_filter(gx, filtered_ax, alpha);
-                        
-                        pong_game.paddle_pos = WIDTH/2 + (filtered_ax * 50);
-                        if (pong_game.paddle_pos < pong_game.paddle_width/2) {
-                            pong_game.paddle_pos = pong_game.paddle_width/2;
-                        }
-                        if (pong_game.paddle_pos > WIDTH - pong_game.paddle_width/2) {
-                            pong_game.paddle_pos = WIDTH - pong_game.paddle_width/2;
-                        }
-                        
-                        pong_game_update(&pong_game);
-                        pong_game_render(&pong_game);
-                        vTaskDelay(GAME_SPEED / portTICK_PERIOD_MS);
-                    }
-                    
-                    bool new_record = false;
-                    int current_high_score = read_high_score("pong");
-                    if (pong_game.score > current_high_score) {
-                        new_record = true;
-                        write_high_score("pong", pong_game.score);
-                        current_high_score = pong_game.score;
-                    }
-                    
-                    show_game_over_screen(pong_game.score, current_high_score, new_record);
-                    
-                } else if (current_selection == GAME_DODGE) {
-                    DodgeGame dodge_game;
-                    dodge_game_init(&dodge_game);
-                    
-                    int16_t ax, ay, az;
-                    float filtered_ax = 0;
-                    const float alpha = 0.2;
-                    
-                    while (!dodge_game.game_over) {
-                        mpu6050_read_accel(&ax, &ay, &az);
-                        float gx = ax / 16384.0;
-                        filtered_ax = low_pass_filter(gx, filtered_ax, alpha);
-                        
-                        dodge_game.player.x += (int)(filtered_ax * 5);
-                        
-                        if (dodge_game.player.x < 0) dodge_game.player.x = 0;
-                        if (dodge_game.player.x > WIDTH - 10) dodge_game.player.x = WIDTH - 10;
-                        
-                        dodge_game_update(&dodge_game);
-                        dodge_game_render(&dodge_game);
-                        vTaskDelay(GAME_SPEED / portTICK_PERIOD_MS);
-                    }
-                    
-                    bool new_record = false;
-                    int current_high_score = read_high_score("dodge");
-                    if (dodge_game.score > current_high_score) {
-                        new_record = true;
-                        write_high_score("dodge", dodge_game.score);
-                        current_high_score = dodge_game.score;
-                    }
-                    
-                    show_game_over_screen(dodge_game.score, current_high_score, new_record);
-                    
-                } else if (current_selection == GAME_TILT_MAZE) {
-                    TiltMazeGame tilt_game;
-                    tilt_maze_init(&tilt_game);
-                    
-                    int16_t ax, ay, az;
-                    float filtered_ax = 0, filtered_ay = 0;
-                    const float alpha = 0.2;
-                    const float threshold = 0.3;
-                    
-                    while (!tilt_game.game_over) {
-                        mpu6050_read_accel(&ax, &ay, &az);
-                        float gx = ax / 16384.0;
-                        float gy = ay / 16384.0;
-                        filtered_ax = low_pass_filter(gx, filtered_ax, alpha);
-                        filtered_ay = low_pass_filter(gy, filtered_ay, alpha);
-                        
-                        int dx = 0, dy = 0;
-                        
-                        if (fabsf(filtered_ax) > threshold || fabsf(filtered_ay) > threshold) {
-                            if (fabsf(filtered_ax) > fabsf(filtered_ay)) {
-                                dx = (filtered_ax > 0) ? 1 : -1;
-                            } else {
-                                dy = (filtered_ay > 0) ? 1 : -1;
-                            }
-                        }
-                        
-                        tilt_maze_update(&tilt_game, dx, dy);
-                        tilt_maze_render(&tilt_game);
-                        
-                        if(tilt_game.level_complete) {
-                            vTaskDelay(2000 / portTICK_PERIOD_MS);
-                            
-                            if(tilt_game.level < 5) {
-                                tilt_maze_init_level(&tilt_game, tilt_game.level + 1);
-                                tilt_game.level_complete = false;
-                                tilt_game.food_count = 4;
-                                
-                                vTaskDelay(500 / portTICK_PERIOD_MS); 
-                            } else {
-                                tilt_game.game_over = true;
-                                
-                                buzzer_play_tone(1000, 100);
-                                vTaskDelay(50 / portTICK_PERIOD_MS);
-                                buzzer_play_tone(1200, 100);
-                                vTaskDelay(50 / portTICK_PERIOD_MS);
-                                buzzer_play_tone(1500, 200);
-                                
-                                int score = tilt_game.level * 100;
-                                bool new_record = false;
-                                int current_high_score = read_high_score("tilt_maze");
-                                if (score > current_high_score) {
-                                    new_record = true;
-                                    write_high_score("tilt_maze", score);
-                                    current_high_score = score;
-                                }
-                                
-                                char end_text[30];
-                                if(tilt_game.level == 5 && tilt_game.level_complete) {
-                                    snprintf(end_text, sizeof(end_text), "Voce venceu!");
-                                } else {
-                                    snprintf(end_text, sizeof(end_text), "Fim de jogo");
-                                }
-                                
-                                clear_screen();
-                                draw_text(WIDTH/2 - 30, HEIGHT/2 - 20, end_text);
-                                draw_text(WIDTH/2 - 40, HEIGHT/2 - 10, "Pontuacao:");
-                                char score_text[20];
-                                snprintf(score_text, sizeof(score_text), "%d", score);
-                                draw_text(WIDTH/2 - 20, HEIGHT/2, score_text);
-                                
-                                if (new_record) {
-                                    draw_text(WIDTH/2 - 40, HEIGHT/2 + 10, "Novo Recorde!");
-                                    play_new_record_sound();
-                                } else {
-                                    draw_text(WIDTH/2 - 40, HEIGHT/2 + 10, "Recorde:");
-                                    snprintf(score_text, sizeof(score_text), "%d", current_high_score);
-                                    draw_text(WIDTH/2 - 20, HEIGHT/2 + 20, score_text);
-                                }
-                                
-                                draw_text(WIDTH/2 - 50, HEIGHT/2 + 30, "Pressione um botao");
-                                update_display();
-                                
-                                while(!gpio_get_level(SELECT_BUTTON) && !gpio_get_level(NAVIGATE_BUTTON)) {
-                                    vTaskDelay(100 / portTICK_PERIOD_MS);
-                                }
-                                while(gpio_get_level(SELECT_BUTTON) || gpio_get_level(NAVIGATE_BUTTON)) {
-                                    vTaskDelay(100 / portTICK_PERIOD_MS);
-                                }
-                            }
-                        }
-                        
-                        vTaskDelay(GAME_SPEED / portTICK_PERIOD_MS);
-                    }
-                }
-                
-                in_menu = true;
-            }
-            
-            vTaskDelay(100 / portTICK_PERIOD_MS);
+            redraw = true;
+        }
+        
+        if (button == BUTTON_SELECT) {
+            play_game(current_selection);
+            report_stack_usage();
+            redraw = true;
         }
     }
 }
@@ -867,7 +1049,29 @@ void app_main() {
     if (!sd_card_initialized) {
         ESP_LOGE(TAG, "Falha ao inicializar o cartão SD. O sistema continuará sem armazenamento de recordes.");
     }
+    scores_init(); // Recordes ficam em RAM a partir daqui
+    
+    // Depois do cartão: os offsets de calibração ficam nele
+    sensor_init();
+    buttons_init();
+    calibrate_sensor();
+    
+#if PROFILER_ENABLED
+    profiler_set_hud(PROFILER_HUD);
+#endif
+    
+#if BENCHMARK_MODE
+    // Sem tarefa de envio: o benchmark só mede os bytes, sem usar o I2C
+    xTaskCreatePinnedToCore(benchmark_task, "benchmark", 8192, NULL, 5, NULL, 1);
+    return;
+#endif
+    
+    // Envio do display e sensor em um núcleo, lógica dos jogos no outro
+    display_start_flush_task(DISPLAY_FLUSH_CORE);
+    sensor_start_task(SENSOR_TASK_CORE);
+    scores_start_task(SCORES_TASK_CORE);
+    replay_start_task(REPLAY_TASK_CORE);
     
     vTaskDelay(100 / portTICK_PERIOD_MS);
-    xTaskCreate(game_task, "game_system", 8192, NULL, 5, NULL);
+    xTaskCreatePinnedToCore(game_task, "game_system", GAME_TASK_STACK_SIZE, NULL, 5, NULL, 1);
 }
@@ -0,0 +1,115 @@
+#include "maze_levels.h"
+#include "maze_levels_data.h"
+#include <esp_log.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "MAZE_LEVELS";
+
+static char levels_dir[128] = MAZE_LEVELS_DIR;
+static int cached_count = -1;
+
+void maze_level_set_dir(const char *dir) {
+    snprintf(levels_dir, sizeof(levels_dir), "%s", dir);
+    cached_count = -1;
+}
+
+static void level_path(char *path, size_t size, int level) {
+    snprintf(path, size, "%s/nivel_%02d.bin", levels_dir, level);
+}
+
+static bool level_file_exists(int level) {
+    char path[160];
+    level_path(path, sizeof(path), level);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+    fclose(f);
+    return true;
+}
+
+int maze_level_count() {
+    if (cached_count >= 0) return cached_count;
+    if (!sd_card_initialized) return MAZE_BUILTIN_LEVELS;
+
+    int count = MAZE_BUILTIN_LEVELS;
+    while (count < 99 && level_file_exists(count + 1)) {
+        count++;
+    }
+    if (count > MAZE_BUILTIN_LEVELS) {
+        ESP_LOGI(TAG, "%d níveis extras no cartão SD", count - MAZE_BUILTIN_LEVELS);
+    }
+    cached_count = count;
+    return count;
+}
+
+// Descomprime pares (repetições, byte) a partir de *filled. Retorna false se
+// algum par passar do fim da grade.
+static bool rle_decode(const uint8_t *pairs, size_t size, uint8_t *grid, size_t *filled) {
+    for (size_t i = 0; i + 1 < size; i += 2) {
+        size_t run = pairs[i];
+        if (run == 0 || *filled + run > BUFFER_SIZE) return false;
+        memset(grid + *filled, pairs[i + 1], run);
+        *filled += run;
+    }
+    return true;
+}
+
+static bool check_info(const MazeLevelInfo *info) {
+    if (info->food_count == 0 || info->food_count > MAZE_MAX_FOODS) return false;
+    if (info->spawn.x >= WIDTH || info->spawn.y >= HEIGHT) return false;
+    return true;
+}
+
+// Lê o arquivo em blocos pequenos e descomprime direto na grade, sem
+// carregar o arquivo inteiro na RAM
+static bool load_from_sd(int level, MazeLevelInfo *info, uint8_t *grid) {
+    char path[160];
+    level_path(path, sizeof(path), level);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+
+    uint8_t chunk[64];
+    bool ok = fread(chunk, 1, MAZE_BIN_HEADER_SIZE, f) == MAZE_BIN_HEADER_SIZE &&
+              memcmp(chunk, MAZE_BIN_MAGIC, 3) == 0;
+    if (ok) {
+        info->spawn = (MazePoint){chunk[3], chunk[4]};
+        info->food_count = chunk[5];
+        for (int i = 0; i < MAZE_MAX_FOODS; i++) {
+            info->foods[i] = (MazePoint){chunk[6 + i * 2], chunk[7 + i * 2]};
+        }
+        ok = check_info(info);
+    }
+
+    size_t filled = 0;
+    size_t n;
+    while (ok && (n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        ok = (n % 2 == 0) && rle_decode(chunk, n, grid, &filled);
+    }
+    fclose(f);
+
+    if (!ok || filled != BUFFER_SIZE) {
+        ESP_LOGE(TAG, "Arquivo de nível inválido: %s", path);
+        return false;
+    }
+    return true;
+}
+
+bool maze_level_load(int level, MazeLevelInfo *info, uint8_t *grid) {
+    if (level < 1) return false;
+
+    if (sd_card_initialized && load_from_sd(level, info, grid)) {
+        return true;
+    }
+    if (level > MAZE_BUILTIN_LEVELS) {
+        ESP_LOGE(TAG, "Nível %d não encontrado", level);
+        return false;
+    }
+
+    const MazeLevelDesc *desc = &maze_builtin_levels[level - 1];
+    size_t filled = 0;
+    info->spawn = desc->spawn;
+    info->food_count = desc->food_count;
+    memcpy(info->foods, desc->foods, sizeof(info->foods));
+    rle_decode(desc->rle, desc->rle_size, grid, &filled);
+    return true;
+}
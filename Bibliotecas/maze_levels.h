@@ -0,0 +1,51 @@
+#ifndef MAZE_LEVELS_H
+#define MAZE_LEVELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "display.h"
+#include "sdcard.h"
+
+// Níveis do Tilt Maze. Os níveis de fábrica ficam em flash como tabelas
+// comprimidas (geradas por Ferramentas/gerar_niveis.py); arquivos
+// nivel_NN.bin no cartão SD substituem um nível de fábrica ou acrescentam
+// níveis depois do último.
+#define MAZE_MAX_FOODS 4
+#define MAZE_LEVELS_DIR MOUNT_POINT "/niveis"
+
+// Arquivo .bin: "MZ" + versão, início (x, y), número de comidas, 4 comidas
+// (x, y) e os pares (repetições, byte) da grade no layout do display_buffer
+#define MAZE_BIN_MAGIC "MZ\x01"
+#define MAZE_BIN_HEADER_SIZE (3 + 2 + 1 + MAZE_MAX_FOODS * 2)
+
+typedef struct {
+    uint8_t x, y;
+} MazePoint;
+
+typedef struct {
+    MazePoint spawn;
+    uint8_t food_count;
+    MazePoint foods[MAZE_MAX_FOODS];
+} MazeLevelInfo;
+
+// Nível de fábrica: cabeçalho + grade comprimida em flash
+typedef struct {
+    MazePoint spawn;
+    uint8_t food_count;
+    MazePoint foods[MAZE_MAX_FOODS];
+    const uint8_t *rle;
+    uint16_t rle_size;
+} MazeLevelDesc;
+
+// Quantidade de níveis (fábrica + extras no SD). Os extras só são procurados
+// depois que o cartão foi montado.
+int maze_level_count();
+
+// Carrega o nível (a partir de 1) e descomprime as paredes direto em grid
+// (BUFFER_SIZE bytes). Retorna false se o nível não existe ou está corrompido.
+bool maze_level_load(int level, MazeLevelInfo *info, uint8_t *grid);
+
+// Troca o diretório dos níveis extras (padrão MAZE_LEVELS_DIR)
+void maze_level_set_dir(const char *dir);
+
+#endif // MAZE_LEVELS_H
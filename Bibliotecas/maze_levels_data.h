@@ -0,0 +1,65 @@
+// Gerado por Ferramentas/gerar_niveis.py a partir de Ferramentas/niveis/.
+// Não edite à mão: altere os desenhos e gere de novo.
+#ifndef MAZE_LEVELS_DATA_H
+#define MAZE_LEVELS_DATA_H
+
+#include "maze_levels.h"
+
+// Nível 1: layout simples (22 bytes)
+static const uint8_t maze_level_1_rle[] = {
+    0xFF, 0x00, 0x3D, 0x00, 0x04, 0xF0, 0x7C, 0x00, 0x04, 0xC0, 0x7C, 0x00, 0x04, 0x03, 0x7C, 0x00,
+    0x04, 0x0F, 0xFF, 0x00, 0x41, 0x00,
+};
+
+// Nível 2: mais paredes em forma de cruz (30 bytes)
+static const uint8_t maze_level_2_rle[] = {
+    0xFF, 0x00, 0x3D, 0x00, 0x04, 0xF0, 0x68, 0x00, 0x14, 0xC0, 0x04, 0xFF, 0x13, 0xC0, 0x55, 0x00,
+    0x14, 0x03, 0x04, 0xFF, 0x13, 0x03, 0x69, 0x00, 0x04, 0x07, 0xFF, 0x00, 0x41, 0x00,
+};
+
+// Nível 3: labirinto mais complexo (50 bytes)
+static const uint8_t maze_level_3_rle[] = {
+    0xA8, 0x00, 0x04, 0xFC, 0x7C, 0x00, 0x04, 0xFF, 0x7C, 0x00, 0x04, 0xFF, 0x31, 0xC0, 0x4B, 0x00,
+    0x04, 0xFF, 0x24, 0x03, 0x04, 0xFF, 0x09, 0x03, 0x4B, 0x00, 0x04, 0xFF, 0x24, 0x00, 0x04, 0xFF,
+    0x54, 0x00, 0x04, 0xFF, 0x24, 0x00, 0x04, 0xFF, 0x54, 0x00, 0x04, 0x7F, 0x24, 0x00, 0x04, 0x7F,
+    0x2C, 0x00,
+};
+
+// Nível 4: corredores em zigue-zague (114 bytes)
+static const uint8_t maze_level_4_rle[] = {
+    0x94, 0x00, 0x04, 0x80, 0x24, 0x00, 0x04, 0x80, 0x24, 0x00, 0x04, 0x80, 0x2C, 0x00, 0x04, 0x87,
+    0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x87, 0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x87,
+    0x2C, 0x00, 0x04, 0x87, 0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x87, 0x10, 0x00, 0x04, 0x78,
+    0x10, 0x00, 0x04, 0x87, 0x2C, 0x00, 0x04, 0x87, 0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x87,
+    0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x87, 0x2C, 0x00, 0x04, 0x87, 0x10, 0x00, 0x04, 0x78,
+    0x10, 0x00, 0x04, 0x87, 0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x87, 0x2C, 0x00, 0x04, 0x07,
+    0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x07, 0x10, 0x00, 0x04, 0x78, 0x10, 0x00, 0x04, 0x07,
+    0x98, 0x00,
+};
+
+// Nível 5: desafio final (86 bytes)
+static const uint8_t maze_level_5_rle[] = {
+    0x94, 0x00, 0x04, 0xFC, 0x24, 0x00, 0x04, 0xFC, 0x54, 0x00, 0x04, 0xFF, 0x24, 0x00, 0x04, 0xFF,
+    0x54, 0x00, 0x04, 0xFF, 0x1D, 0xC0, 0x07, 0x00, 0x04, 0xFF, 0x07, 0x00, 0x2A, 0xC0, 0x23, 0x00,
+    0x04, 0xFF, 0x1D, 0x03, 0x07, 0x00, 0x04, 0x01, 0x07, 0x00, 0x13, 0x03, 0x04, 0xFF, 0x13, 0x03,
+    0x23, 0x00, 0x04, 0xFF, 0x24, 0x00, 0x04, 0xFE, 0x1A, 0x00, 0x04, 0xFF, 0x36, 0x00, 0x04, 0xFF,
+    0x24, 0x00, 0x04, 0xFF, 0x1A, 0x00, 0x04, 0xFF, 0x36, 0x00, 0x04, 0x7F, 0x24, 0x00, 0x04, 0x7F,
+    0x1A, 0x00, 0x04, 0x7F, 0x22, 0x00,
+};
+
+#define MAZE_BUILTIN_LEVELS 5
+
+static const MazeLevelDesc maze_builtin_levels[MAZE_BUILTIN_LEVELS] = {
+    { {10, 10}, 4, {{30, 10}, {90, 10}, {30, 50}, {90, 50}},
+      maze_level_1_rle, sizeof(maze_level_1_rle) },
+    { {10, 10}, 4, {{20, 20}, {100, 20}, {20, 40}, {100, 40}},
+      maze_level_2_rle, sizeof(maze_level_2_rle) },
+    { {10, 10}, 4, {{10, 10}, {110, 10}, {10, 50}, {110, 50}},
+      maze_level_3_rle, sizeof(maze_level_3_rle) },
+    { {10, 10}, 4, {{10, 10}, {110, 10}, {10, 50}, {110, 50}},
+      maze_level_4_rle, sizeof(maze_level_4_rle) },
+    { {10, 10}, 4, {{5, 5}, {115, 5}, {5, 55}, {115, 55}},
+      maze_level_5_rle, sizeof(maze_level_5_rle) },
+};
+
+#endif // MAZE_LEVELS_DATA_H
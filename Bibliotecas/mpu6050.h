@@ -1,7 +1,9 @@
 #ifndef MPU6050_H
 #define MPU6050_H
 
+#include <driver/gpio.h>
 #include <driver/i2c.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 // MPU-6050
@@ -9,8 +11,65 @@
 #define MPU6050_ACCEL_XOUT_H 0x3B
 #define MPU6050_PWR_MGMT_1 0x6B
 
+// Registradores do FIFO
+#define MPU6050_SMPLRT_DIV 0x19
+#define MPU6050_CONFIG 0x1A
+#define MPU6050_FIFO_EN 0x23
+#define MPU6050_INT_PIN_CFG 0x37
+#define MPU6050_INT_ENABLE 0x38
+#define MPU6050_USER_CTRL 0x6A
+#define MPU6050_FIFO_COUNT_H 0x72
+#define MPU6050_FIFO_R_W 0x74
+
+#define MPU6050_DLPF_CFG 0x02              // filtro interno ~94 Hz, giroscópio a 1 kHz
+#define MPU6050_FIFO_EN_ACCEL 0x08
+#define MPU6050_FIFO_EN_GYRO 0x70          // XG, YG e ZG
+#define MPU6050_USER_CTRL_FIFO_EN 0x40
+#define MPU6050_USER_CTRL_FIFO_RESET 0x04
+#define MPU6050_INT_RD_CLEAR 0x10          // qualquer leitura limpa o status
+#define MPU6050_INT_DATA_RDY_EN 0x01
+#define MPU6050_PWR_SLEEP 0x40             // bit SLEEP do PWR_MGMT_1
+
+// Espera pelo barramento: o envio de um quadro inteiro do display ocupa o
+// I2C por ~25 ms, então o prazo é o mesmo do envio (100 ms)
+#define MPU6050_I2C_TIMEOUT_MS 100
+
+// Pino INT do MPU6050 (pulso de 50 us a cada amostra nova)
+#define MPU6050_INT_PIN GPIO_NUM_26
+
+#define MPU6050_FIFO_SIZE 1024
+#define MPU6050_FIFO_SAMPLE_BYTES 12       // acelerômetro + giroscópio
+#define MPU6050_FIFO_MAX_BATCH 32          // amostras por leitura em rajada
+
+// Uma amostra do FIFO (valores brutos: 16384 = 1 g, 131 = 1 grau/s)
+typedef struct {
+    int16_t ax, ay, az;
+    int16_t gx, gy, gz;
+} Mpu6050Sample;
+
 void mpu6050_init();
 void mpu6050_read_accel(int16_t *ax, int16_t *ay, int16_t *az);
 float low_pass_filter(float new_value, float old_value, float alpha);
 
+// Mesma leitura do acelerômetro, mas pelo barramento travado (i2c_bus.h):
+// é a que vale depois do boot, com o envio do display rodando em paralelo.
+// Retorna false se o barramento não ficou livre a tempo.
+bool mpu6050_read_accel_locked(int16_t *ax, int16_t *ay, int16_t *az);
+
+// Modo FIFO: o sensor guarda acelerômetro e giroscópio na taxa pedida
+// (4 a 1000 Hz) e mpu6050_fifo_read() drena até max_samples amostras com
+// uma leitura do contador e uma leitura em rajada. Retorna quantas leu.
+// mpu6050_fifo_reset() descarta o que acumulou (ex.: enquanto estava no menu).
+bool mpu6050_fifo_start(int sample_rate_hz);
+void mpu6050_fifo_stop();
+void mpu6050_fifo_reset();
+
+// Liga o pulso de "dado pronto" no pino INT a cada amostra
+bool mpu6050_enable_data_ready_int();
+int mpu6050_fifo_read(Mpu6050Sample *samples, int max_samples);
+
+// Modo sleep (~5 uA): os registradores, inclusive a configuração do FIFO,
+// são mantidos. Ao acordar o giroscópio leva ~30 ms para estabilizar.
+bool mpu6050_set_sleep(bool sleep);
+
 #endif // MPU6050_H
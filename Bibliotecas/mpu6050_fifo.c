@@ -0,0 +1,144 @@
+#include "mpu6050.h"
+#include "i2c_bus.h"
+#include <freertos/FreeRTOS.h>
+#include <esp_log.h>
+
+static const char *TAG = "MPU6050_FIFO";
+
+static bool fifo_running = false;
+
+static esp_err_t mpu6050_write_reg(uint8_t reg, uint8_t value) {
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (MPU6050_ADDR << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, reg, true);
+    i2c_master_write_byte(cmd, value, true);
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_bus_transfer(cmd, MPU6050_I2C_TIMEOUT_MS / portTICK_PERIOD_MS);
+    i2c_cmd_link_delete(cmd);
+    return ret;
+}
+
+// Leitura em rajada: um único start repetido, o MPU6050 incrementa o
+// registrador sozinho (no FIFO_R_W ele continua entregando o próximo byte)
+static esp_err_t mpu6050_read_regs(uint8_t reg, uint8_t *data, size_t len) {
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (MPU6050_ADDR << 1) | I2C_MASTER_WRITE, true);
+    i2c_master_write_byte(cmd, reg, true);
+    i2c_master_start(cmd);
+    i2c_master_write_byte(cmd, (MPU6050_ADDR << 1) | I2C_MASTER_READ, true);
+    i2c_master_read(cmd, data, len, I2C_MASTER_LAST_NACK);
+    i2c_master_stop(cmd);
+    esp_err_t ret = i2c_bus_transfer(cmd, MPU6050_I2C_TIMEOUT_MS / portTICK_PERIOD_MS);
+    i2c_cmd_link_delete(cmd);
+    return ret;
+}
+
+bool mpu6050_read_accel_locked(int16_t *ax, int16_t *ay, int16_t *az) {
+    uint8_t raw[6];
+    if (mpu6050_read_regs(MPU6050_ACCEL_XOUT_H, raw, 6) != ESP_OK) return false;
+
+    *ax = (int16_t)((raw[0] << 8) | raw[1]);
+    *ay = (int16_t)((raw[2] << 8) | raw[3]);
+    *az = (int16_t)((raw[4] << 8) | raw[5]);
+    return true;
+}
+
+void mpu6050_fifo_reset() {
+    mpu6050_write_reg(MPU6050_USER_CTRL, MPU6050_USER_CTRL_FIFO_RESET);
+    mpu6050_write_reg(MPU6050_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN);
+}
+
+bool mpu6050_fifo_start(int sample_rate_hz) {
+    if (sample_rate_hz < 4 || sample_rate_hz > 1000) {
+        ESP_LOGE(TAG, "Taxa de amostragem inválida: %d Hz", sample_rate_hz);
+        return false;
+    }
+
+    // Com o DLPF ligado o giroscópio amostra a 1 kHz:
+    // taxa = 1000 / (1 + SMPLRT_DIV)
+    esp_err_t ret = mpu6050_write_reg(MPU6050_CONFIG, MPU6050_DLPF_CFG);
+    if (ret == ESP_OK) ret = mpu6050_write_reg(MPU6050_SMPLRT_DIV, 1000 / sample_rate_hz - 1);
+    if (ret == ESP_OK) ret = mpu6050_write_reg(MPU6050_USER_CTRL, 0);
+    if (ret == ESP_OK) ret = mpu6050_write_reg(MPU6050_FIFO_EN, MPU6050_FIFO_EN_ACCEL | MPU6050_FIFO_EN_GYRO);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao configurar o FIFO: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    mpu6050_fifo_reset();
+    fifo_running = true;
+    ESP_LOGI(TAG, "FIFO ativo a %d Hz", sample_rate_hz);
+    return true;
+}
+
+bool mpu6050_enable_data_ready_int() {
+    esp_err_t ret = mpu6050_write_reg(MPU6050_INT_PIN_CFG, MPU6050_INT_RD_CLEAR);
+    if (ret == ESP_OK) ret = mpu6050_write_reg(MPU6050_INT_ENABLE, MPU6050_INT_DATA_RDY_EN);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao ligar a interrupção de dado pronto: %s", esp_err_to_name(ret));
+        return false;
+    }
+    return true;
+}
+
+// Só mexe no bit SLEEP: a fonte de relógio escolhida no mpu6050_init() fica
+bool mpu6050_set_sleep(bool sleep) {
+    uint8_t value;
+    esp_err_t ret = mpu6050_read_regs(MPU6050_PWR_MGMT_1, &value, 1);
+    if (ret == ESP_OK) {
+        value = sleep ? (value | MPU6050_PWR_SLEEP) : (value & ~MPU6050_PWR_SLEEP);
+        ret = mpu6050_write_reg(MPU6050_PWR_MGMT_1, value);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao %s o sensor: %s", sleep ? "adormecer" : "acordar", esp_err_to_name(ret));
+        return false;
+    }
+    return true;
+}
+
+void mpu6050_fifo_stop() {
+    mpu6050_write_reg(MPU6050_FIFO_EN, 0);
+    mpu6050_write_reg(MPU6050_USER_CTRL, 0);
+    fifo_running = false;
+}
+
+int mpu6050_fifo_read(Mpu6050Sample *samples, int max_samples) {
+    static uint8_t raw[MPU6050_FIFO_MAX_BATCH * MPU6050_FIFO_SAMPLE_BYTES];
+    uint8_t count_raw[2];
+
+    if (!fifo_running) return 0;
+    if (mpu6050_read_regs(MPU6050_FIFO_COUNT_H, count_raw, 2) != ESP_OK) return 0;
+
+    int count = (count_raw[0] << 8) | count_raw[1];
+
+    // FIFO cheio: descartou amostras e o alinhamento dos 12 bytes se perdeu
+    if (count >= MPU6050_FIFO_SIZE) {
+        ESP_LOGW(TAG, "FIFO transbordou, reiniciando");
+        mpu6050_fifo_reset();
+        return 0;
+    }
+
+    int n = count / MPU6050_FIFO_SAMPLE_BYTES;
+    if (n > max_samples) n = max_samples;
+    if (n > MPU6050_FIFO_MAX_BATCH) n = MPU6050_FIFO_MAX_BATCH;
+    if (n == 0) return 0;
+
+    if (mpu6050_read_regs(MPU6050_FIFO_R_W, raw, n * MPU6050_FIFO_SAMPLE_BYTES) != ESP_OK) {
+        mpu6050_fifo_reset();
+        return 0;
+    }
+
+    // Ordem no FIFO: acelerômetro X, Y, Z e giroscópio X, Y, Z (big-endian)
+    for (int i = 0; i < n; i++) {
+        const uint8_t *p = &raw[i * MPU6050_FIFO_SAMPLE_BYTES];
+        samples[i].ax = (int16_t)((p[0] << 8) | p[1]);
+        samples[i].ay = (int16_t)((p[2] << 8) | p[3]);
+        samples[i].az = (int16_t)((p[4] << 8) | p[5]);
+        samples[i].gx = (int16_t)((p[6] << 8) | p[7]);
+        samples[i].gy = (int16_t)((p[8] << 8) | p[9]);
+        samples[i].gz = (int16_t)((p[10] << 8) | p[11]);
+    }
+    return n;
+}
@@ -0,0 +1,25 @@
+#include "physics.h"
+
+// sen/cos de 0 a 60 graus em passos de 7.5, em Q12 (4096 = 1.0)
+static const int16_t direction_table[PHYSICS_ANGLE_STEPS + 1][2] = {
+    { 0, 4096 }, { 535, 4061 }, { 1060, 3956 }, { 1567, 3784 }, { 2048, 3547 },
+    { 2493, 3250 }, { 2896, 2896 }, { 3250, 2493 }, { 3547, 2048 },
+};
+
+FxVec physics_direction_up(fx_t speed, int angle_step) {
+    int step = angle_step < 0 ? -angle_step : angle_step;
+    if (step > PHYSICS_ANGLE_STEPS) step = PHYSICS_ANGLE_STEPS;
+
+    fx_t x = (fx_t)(((int64_t)speed * direction_table[step][0]) >> 12);
+    fx_t y = (fx_t)(((int64_t)speed * direction_table[step][1]) >> 12);
+    return (FxVec){ angle_step < 0 ? -x : x, -y };
+}
+
+bool physics_sweep_down(FxVec from, FxVec to, fx_t line_y, fx_t *x_at) {
+    if (from.y > line_y || to.y < line_y || to.y == from.y) return false;
+
+    // Interpolação no ponto do cruzamento (fração do tick em 64 bits)
+    int64_t dy = to.y - from.y;
+    *x_at = from.x + (fx_t)((int64_t)(to.x - from.x) * (line_y - from.y) / dy);
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Física dos jogos em ponto fixo 24.8 (256 = 1 pixel): posição e velocidade
+// em frações de pixel, sem float. Velocidades são por tick, mas definidas em
+// pixels por segundo com FX_PER_TICK, então mudar o tick não muda o jogo.
+typedef int32_t fx_t;
+
+#define FX_SHIFT 8
+#define FX_ONE (1 << FX_SHIFT)
+#define FX(x) ((fx_t)((x) * FX_ONE))                 // constantes
+#define FX_FROM_INT(i) ((fx_t)(i) * FX_ONE)
+#define FX_TO_INT(f) ((int)((f) >> FX_SHIFT))        // arredonda para baixo
+#define FX_PER_TICK(px_per_s, tick_ms) ((fx_t)((px_per_s) * FX_ONE * (tick_ms) / 1000 + 0.5))
+
+typedef struct {
+    fx_t x, y;
+} FxVec;
+
+static inline fx_t fx_mul(fx_t a, fx_t b) {
+    return (fx_t)(((int64_t)a * b) >> FX_SHIFT);
+}
+
+// Direções de rebote: ângulo a partir da vertical em passos de 7.5 graus,
+// de -PHYSICS_ANGLE_STEPS (60 graus à esquerda) a +PHYSICS_ANGLE_STEPS
+#define PHYSICS_ANGLE_STEPS 8
+
+// Vetor de módulo speed subindo (y negativo) no ângulo dado
+FxVec physics_direction_up(fx_t speed, int angle_step);
+
+// Varredura: o segmento from -> to cruza a reta y = line_y descendo? Se
+// cruzar, *x_at recebe o x no ponto de cruzamento. Pega a colisão mesmo
+// quando um tick pula por cima de um objeto mais fino que a velocidade.
+bool physics_sweep_down(FxVec from, FxVec to, fx_t line_y, fx_t *x_at);
+
+#endif // PHYSICS_H
@@ -0,0 +1,57 @@
+#include "power.h"
+
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+#include "buttons.h"
+#include "buzzer.h"
+#include "display.h"
+#include "mpu6050.h"
+#include "replay.h"
+#include "scores.h"
+
+static const char *TAG = "POWER";
+
+static PowerStats stats;
+
+bool power_idle_sleep() {
+    ESP_LOGI(TAG, "Ocioso há %d s, entrando em light sleep", POWER_IDLE_TIMEOUT_MS / 1000);
+
+    // O que estiver pendente vai para o cartão antes: dormindo com bateria
+    // fraca, o aparelho pode não acordar mais
+    scores_flush();
+    replay_flush();
+    buzzer_stop();
+    display_set_power(false);
+    mpu6050_set_sleep(true);
+
+    buttons_arm_wakeup();
+    esp_sleep_enable_gpio_wakeup();
+    int64_t slept = esp_timer_get_time();
+    esp_err_t ret = esp_light_sleep_start();
+    int64_t woke = esp_timer_get_time();
+    buttons_disarm_wakeup();
+
+    // Tela primeiro: é o que o jogador vê; o sensor só é lido na próxima
+    // partida (sensor_reset() descarta o que o FIFO juntar até lá)
+    display_set_power(true);
+    uint32_t wake_us = (uint32_t)(esp_timer_get_time() - woke);
+    mpu6050_set_sleep(false);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Light sleep recusado: %s", esp_err_to_name(ret));
+        return false;
+    }
+    stats.sleeps++;
+    stats.slept_us += woke - slept;
+    stats.last_wake_us = wake_us;
+    ESP_LOGI(TAG, "Acordou após %lld s, tela de volta em %u us",
+             (long long)((woke - slept) / 1000000), (unsigned)wake_us);
+    return true;
+}
+
+void power_get_stats(PowerStats *out) {
+    *out = stats;
+}
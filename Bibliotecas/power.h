@@ -0,0 +1,26 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Ocioso: sem aperto de botão por este tempo no menu ou nas telas de fim de
+// jogo, o aparelho apaga a tela, põe o MPU6050 para dormir e entra em light
+// sleep até um botão ser apertado (pode ser trocado com -DPOWER_IDLE_TIMEOUT_MS)
+#ifndef POWER_IDLE_TIMEOUT_MS
+#define POWER_IDLE_TIMEOUT_MS 30000
+#endif
+
+typedef struct {
+    uint32_t sleeps;           // vezes que entrou em light sleep
+    int64_t slept_us;          // tempo total dormindo
+    uint32_t last_wake_us;     // do despertar até a tela ligada de novo
+} PowerStats;
+
+// Dorme até um botão acordar o chip e restaura tela e sensor. O aperto que
+// acordou é descartado. Retorna false se o light sleep foi recusado (ex.:
+// botão já pressionado), com tudo religado.
+bool power_idle_sleep();
+void power_get_stats(PowerStats *stats);
+
+#endif // POWER_H
@@ -0,0 +1,114 @@
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+
+#include "display.h"
+
+static const char *TAG = "profiler";
+
+static const char *stage_names[PROF_STAGE_COUNT] = {
+    "input", "update", "render", "flush", "frame"
+};
+
+// Anel de amostras por etapa; cada etapa é escrita por uma única tarefa
+typedef struct {
+    uint32_t samples[PROFILER_SAMPLES];
+    uint32_t head;
+    uint32_t count;
+} StageRing;
+
+static StageRing rings[PROF_STAGE_COUNT];
+static uint32_t frame_count = 0;
+static int64_t interval_start_us = 0;
+static uint32_t fps_x10 = 0;
+static bool hud_enabled = false;
+
+void profiler_record(ProfilerStage stage, uint32_t elapsed_us) {
+    StageRing *ring = &rings[stage];
+    ring->samples[ring->head] = elapsed_us;
+    ring->head = (ring->head + 1) % PROFILER_SAMPLES;
+    if (ring->count < PROFILER_SAMPLES) ring->count++;
+}
+
+void profiler_scope_end(ProfilerScope *scope) {
+    profiler_record(scope->stage, (uint32_t)(esp_timer_get_time() - scope->start_us));
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+void profiler_get_stats(ProfilerStage stage, ProfilerStats *stats) {
+    const StageRing *ring = &rings[stage];
+    uint32_t sorted[PROFILER_SAMPLES];
+    uint32_t n = ring->count;
+
+    memset(stats, 0, sizeof(*stats));
+    if (n == 0) return;
+
+    uint64_t sum = 0;
+    memcpy(sorted, ring->samples, n * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; i++) sum += sorted[i];
+    qsort(sorted, n, sizeof(uint32_t), compare_u32);
+
+    stats->min_us = sorted[0];
+    stats->avg_us = (uint32_t)(sum / n);
+    stats->p99_us = sorted[(n * 99) / 100];
+    stats->count = n;
+}
+
+void profiler_dump() {
+    ESP_LOGI(TAG, "%u.%u fps", (unsigned)(fps_x10 / 10), (unsigned)(fps_x10 % 10));
+    for (int s = 0; s < PROF_STAGE_COUNT; s++) {
+        ProfilerStats st;
+        profiler_get_stats(s, &st);
+        if (st.count == 0) continue;
+        ESP_LOGI(TAG, "%-6s min %6u  avg %6u  p99 %6u us", stage_names[s],
+                 (unsigned)st.min_us, (unsigned)st.avg_us, (unsigned)st.p99_us);
+    }
+}
+
+void profiler_frame_end() {
+    int64_t now = esp_timer_get_time();
+    if (interval_start_us == 0) interval_start_us = now;
+
+    if (++frame_count % PROFILER_LOG_INTERVAL == 0) {
+        int64_t elapsed = now - interval_start_us;
+        if (elapsed > 0) {
+            fps_x10 = (uint32_t)((int64_t)PROFILER_LOG_INTERVAL * 10000000 / elapsed);
+        }
+        interval_start_us = now;
+        profiler_dump();
+    }
+}
+
+void profiler_set_hud(bool enabled) {
+    hud_enabled = enabled;
+}
+
+// Canto inferior direito: quadros por segundo e duração média do quadro
+void profiler_draw_hud() {
+    if (!hud_enabled) return;
+
+    ProfilerStats frame;
+    profiler_get_stats(PROF_FRAME, &frame);
+
+    char text[24];
+    snprintf(text, sizeof(text), "%u %ums", (unsigned)(fps_x10 / 10), (unsigned)(frame.avg_us / 1000));
+    int x = WIDTH - (int)strlen(text) * 6;
+    for (int i = x - 1; i < WIDTH; i++) {
+        for (int j = HEIGHT - 8; j < HEIGHT; j++) {
+            draw_pixel(i, j, false);
+        }
+    }
+    draw_text(x, HEIGHT - 8, text);
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,77 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Perfil por quadro. Compile com -DPROFILER_ENABLED=1 para ativar; desligado,
+// todas as macros abaixo viram nada e o laço dos jogos fica intocado.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+
+// HUD de FPS no OLED durante as partidas (só com o perfil ativo); compile
+// com -DPROFILER_HUD=0 para ficar só com o relatório no log
+#ifndef PROFILER_HUD
+#define PROFILER_HUD 1
+#endif
+
+#define PROFILER_SAMPLES 64        // amostras guardadas por etapa
+#define PROFILER_LOG_INTERVAL 100  // quadros entre relatórios no log
+
+typedef enum {
+    PROF_INPUT = 0,  // leitura do MPU6050 + filtro
+    PROF_UPDATE,     // *_update
+    PROF_RENDER,     // *_render (inclui a espera pelo envio anterior)
+    PROF_FLUSH,      // envio I2C na tarefa do display
+    PROF_FRAME,      // quadro inteiro, sem a espera do escalonador
+    PROF_STAGE_COUNT
+} ProfilerStage;
+
+typedef struct {
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p99_us;
+    uint32_t count;
+} ProfilerStats;
+
+#if PROFILER_ENABLED
+
+#include <esp_timer.h>
+
+typedef struct {
+    ProfilerStage stage;
+    int64_t start_us;
+} ProfilerScope;
+
+void profiler_record(ProfilerStage stage, uint32_t elapsed_us);
+void profiler_scope_end(ProfilerScope *scope);
+void profiler_frame_end();
+void profiler_get_stats(ProfilerStage stage, ProfilerStats *stats);
+void profiler_dump();
+void profiler_set_hud(bool enabled);
+void profiler_draw_hud();
+
+#define PROFILER_CONCAT_(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_(a, b)
+
+// Mede do ponto da declaração até o fim do bloco
+#define PROFILE_SCOPE(stage) \
+    ProfilerScope PROFILER_CONCAT(prof_scope_, __LINE__) \
+        __attribute__((cleanup(profiler_scope_end))) = { (stage), esp_timer_get_time() }
+#define PROFILE_BEGIN(stage) int64_t prof_start_##stage = esp_timer_get_time()
+#define PROFILE_END(stage) profiler_record((stage), (uint32_t)(esp_timer_get_time() - prof_start_##stage))
+#define PROFILE_FRAME_END() profiler_frame_end()
+#define PROFILE_HUD() profiler_draw_hud()
+
+#else
+
+#define PROFILE_SCOPE(stage) do {} while (0)
+#define PROFILE_BEGIN(stage) do {} while (0)
+#define PROFILE_END(stage) do {} while (0)
+#define PROFILE_FRAME_END() do {} while (0)
+#define PROFILE_HUD() do {} while (0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
@@ -0,0 +1,345 @@
+#include "replay.h"
+
+#include <string.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
+
+static const char *TAG = "REPLAY";
+
+#define REPLAY_REPEAT_FLAG 0x80
+#define REPLAY_REPEAT_MAX 0x7F
+#define REPLAY_X_CHANGED 0x10
+#define REPLAY_Y_CHANGED 0x20
+
+static char replay_dir[128] = REPLAY_DIR;
+
+void replay_set_dir(const char *dir) {
+    snprintf(replay_dir, sizeof(replay_dir), "%s", dir);
+}
+
+void replay_path(char *path, size_t size, const char *game_name) {
+    snprintf(path, size, "%s/%s.rpl", replay_dir, game_name);
+}
+
+// Pedidos para a tarefa de gravação, na ordem da partida: criar o arquivo
+// com o cabeçalho inicial, acrescentar um bloco, regravar o cabeçalho final
+// e fechar, ou só avisar que chegou até ali (replay_flush)
+typedef enum {
+    REPLAY_JOB_OPEN,
+    REPLAY_JOB_CHUNK,
+    REPLAY_JOB_CLOSE,
+    REPLAY_JOB_SYNC,
+} ReplayJobType;
+
+typedef struct {
+    uint8_t type;            // ReplayJobType
+    uint8_t chunk;           // REPLAY_JOB_CHUNK
+    uint16_t used;
+    bool failed;             // REPLAY_JOB_CLOSE: não regrava o cabeçalho
+    ReplayHeader header;     // REPLAY_JOB_OPEN e REPLAY_JOB_CLOSE
+    char path[160];          // REPLAY_JOB_OPEN
+} ReplayJob;
+
+// Os blocos livres circulam por free_chunks; o arquivo só é usado por quem
+// executa os pedidos (a tarefa, ou o próprio jogo quando ela não existe)
+static uint8_t chunks[REPLAY_BUFFERS][REPLAY_CHUNK];
+static QueueHandle_t free_chunks = NULL;
+static QueueHandle_t jobs = NULL;
+static SemaphoreHandle_t synced = NULL;
+static TaskHandle_t writer_task = NULL;
+static FILE *replay_file = NULL;
+static bool replay_io_failed = false;
+
+static void release_chunk(uint8_t chunk) {
+    if (writer_task != NULL) xQueueSend(free_chunks, &chunk, 0);
+}
+
+static void run_job(const ReplayJob *job) {
+    switch (job->type) {
+    case REPLAY_JOB_OPEN:
+        mkdir(replay_dir, 0755);
+        replay_file = fopen(job->path, "wb");
+        replay_io_failed = replay_file == NULL ||
+                           fwrite(&job->header, sizeof(job->header), 1, replay_file) != 1;
+        if (replay_io_failed) {
+            ESP_LOGE(TAG, "Não foi possível criar %s", job->path);
+        }
+        break;
+    case REPLAY_JOB_CHUNK:
+        if (replay_file != NULL && !replay_io_failed &&
+            fwrite(chunks[job->chunk], 1, job->used, replay_file) != job->used) {
+            ESP_LOGE(TAG, "Falha ao gravar a partida, gravação interrompida");
+            replay_io_failed = true;
+        }
+        release_chunk(job->chunk);
+        break;
+    case REPLAY_JOB_CLOSE:
+        if (replay_file == NULL) break;
+        // Sem o cabeçalho final (ticks = 0), o leitor vai até o fim do arquivo
+        if (!job->failed && !replay_io_failed &&
+            (fseek(replay_file, 0, SEEK_SET) != 0 ||
+             fwrite(&job->header, sizeof(job->header), 1, replay_file) != 1)) {
+            ESP_LOGE(TAG, "Falha ao fechar a partida gravada");
+        }
+        fclose(replay_file);
+        replay_file = NULL;
+        break;
+    case REPLAY_JOB_SYNC:
+        xSemaphoreGive(synced);
+        break;
+    }
+}
+
+// A fila tem lugar para todos os blocos mais abrir, fechar e sincronizar
+static bool submit(const ReplayJob *job) {
+    if (writer_task == NULL) {
+        run_job(job);
+        return true;
+    }
+    if (xQueueSend(jobs, job, 0) != pdTRUE) {
+        ESP_LOGE(TAG, "Fila de gravação cheia");
+        return false;
+    }
+    return true;
+}
+
+// Sem a tarefa o bloco 0 é gravado na hora e volta livre
+static bool take_chunk(uint8_t *chunk) {
+    if (writer_task == NULL) {
+        *chunk = 0;
+        return true;
+    }
+    return xQueueReceive(free_chunks, chunk, 0) == pdTRUE;
+}
+
+// Entrega o bloco à tarefa e passa a preencher um livre; sem nenhum livre a
+// gravação é interrompida e os ticks seguintes são ignorados
+static void writer_flush(ReplayWriter *w) {
+    if (w->used == 0 || w->failed) return;
+
+    ReplayJob job = { .type = REPLAY_JOB_CHUNK, .chunk = w->chunk, .used = w->used };
+    w->used = 0;
+    if (!submit(&job)) {
+        release_chunk(job.chunk);
+        w->failed = true;
+    } else if (!take_chunk(&w->chunk)) {
+        ESP_LOGE(TAG, "Cartão atrasado, gravação da partida interrompida");
+        w->failed = true;
+    }
+}
+
+// Todo byte passa por aqui, inclusive os de repetição: o bloco cheio é
+// trocado antes de receber o próximo
+static void writer_put(ReplayWriter *w, uint8_t byte) {
+    if (w->used == REPLAY_CHUNK) writer_flush(w);
+    if (w->failed) return;
+    chunks[w->chunk][w->used++] = byte;
+}
+
+static void writer_put_delta(ReplayWriter *w, int32_t delta) {
+    uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+    while (zigzag >= 0x80) {
+        writer_put(w, (uint8_t)(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    writer_put(w, (uint8_t)zigzag);
+}
+
+static void writer_end_repeat(ReplayWriter *w) {
+    if (w->repeat == 0) return;
+    writer_put(w, REPLAY_REPEAT_FLAG | w->repeat);
+    w->repeat = 0;
+}
+
+bool replay_writer_open(ReplayWriter *w, const char *path, uint8_t game, uint32_t seed, uint16_t tick_ms) {
+    static ReplayJob job;
+
+    memset(w, 0, sizeof(*w));
+    if (!sd_card_initialized) return false;
+    if (!take_chunk(&w->chunk)) {
+        ESP_LOGE(TAG, "Gravação anterior ainda pendente, partida não gravada");
+        return false;
+    }
+
+    memcpy(w->header.magic, REPLAY_MAGIC, 2);
+    w->header.version = REPLAY_VERSION;
+    w->header.game = game;
+    w->header.seed = seed;
+    w->header.tick_ms = tick_ms;
+
+    memset(&job, 0, sizeof(job));
+    job.type = REPLAY_JOB_OPEN;
+    job.header = w->header;
+    snprintf(job.path, sizeof(job.path), "%s", path);
+    if (!submit(&job)) {
+        release_chunk(w->chunk);
+        return false;
+    }
+    w->active = true;
+    return true;
+}
+
+void replay_writer_tick(ReplayWriter *w, const TiltInput *input) {
+    if (!w->active || w->failed) return;
+    w->header.ticks++;
+
+    if (memcmp(input, &w->last, sizeof(*input)) == 0 && w->header.ticks > 1) {
+        if (++w->repeat == REPLAY_REPEAT_MAX) writer_end_repeat(w);
+        return;
+    }
+    writer_end_repeat(w);
+
+    int32_t dx = input->x - w->last.x;
+    int32_t dy = input->y - w->last.y;
+    uint8_t control = (uint8_t)((input->dir_x + 1) | ((input->dir_y + 1) << 2));
+    if (dx != 0) control |= REPLAY_X_CHANGED;
+    if (dy != 0) control |= REPLAY_Y_CHANGED;
+
+    writer_put(w, control);
+    if (dx != 0) writer_put_delta(w, dx);
+    if (dy != 0) writer_put_delta(w, dy);
+    w->last = *input;
+}
+
+// O último bloco vai sem esperar por um livre; a tarefa o devolve depois
+bool replay_writer_close(ReplayWriter *w, int32_t final_score) {
+    static ReplayJob job;
+
+    if (!w->active) return false;
+    writer_end_repeat(w);
+    if (!w->failed) {
+        ReplayJob chunk = { .type = REPLAY_JOB_CHUNK, .chunk = w->chunk, .used = w->used };
+        if (!submit(&chunk)) {
+            release_chunk(chunk.chunk);
+            w->failed = true;
+        }
+    }
+    w->header.final_score = final_score;
+
+    memset(&job, 0, sizeof(job));
+    job.type = REPLAY_JOB_CLOSE;
+    job.failed = w->failed;
+    job.header = w->header;
+    bool ok = submit(&job) && !w->failed;
+    w->active = false;
+    return ok;
+}
+
+void replay_flush() {
+    if (writer_task == NULL) return;
+    ReplayJob job = { .type = REPLAY_JOB_SYNC };
+    xQueueSend(jobs, &job, portMAX_DELAY);
+    xSemaphoreTake(synced, portMAX_DELAY);
+}
+
+static void replay_task(void *pvParameters) {
+    static ReplayJob job;
+    while (1) {
+        xQueueReceive(jobs, &job, portMAX_DELAY);
+        run_job(&job);
+    }
+}
+
+bool replay_start_task(int core) {
+    if (writer_task != NULL) return true;
+
+    free_chunks = xQueueCreate(REPLAY_BUFFERS, sizeof(uint8_t));
+    jobs = xQueueCreate(REPLAY_BUFFERS + 3, sizeof(ReplayJob));
+    synced = xSemaphoreCreateBinary();
+    if (free_chunks == NULL || jobs == NULL || synced == NULL) {
+        ESP_LOGE(TAG, "Falha ao criar a tarefa de gravação, gravando na hora");
+        return false;
+    }
+    for (uint8_t i = 0; i < REPLAY_BUFFERS; i++) {
+        xQueueSend(free_chunks, &i, 0);
+    }
+    if (xTaskCreatePinnedToCore(replay_task, "replay", 3072, NULL, REPLAY_TASK_PRIORITY,
+                                &writer_task, core) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar a tarefa de gravação, gravando na hora");
+        writer_task = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool replay_reader_open(ReplayReader *r, const char *path) {
+    memset(r, 0, sizeof(*r));
+    r->file = fopen(path, "rb");
+    if (r->file == NULL) return false;
+
+    if (fread(&r->header, sizeof(r->header), 1, r->file) != 1 ||
+        memcmp(r->header.magic, REPLAY_MAGIC, 2) != 0 || r->header.version != REPLAY_VERSION) {
+        ESP_LOGE(TAG, "Arquivo de partida inválido: %s", path);
+        replay_reader_close(r);
+        return false;
+    }
+    return true;
+}
+
+// Próximo byte do arquivo; -1 no fim
+static int reader_get(ReplayReader *r) {
+    if (r->pos == r->used) {
+        r->used = fread(r->chunk, 1, REPLAY_CHUNK, r->file);
+        r->pos = 0;
+        if (r->used == 0) return -1;
+    }
+    return r->chunk[r->pos++];
+}
+
+static bool reader_get_delta(ReplayReader *r, int32_t *delta) {
+    uint32_t zigzag = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        int byte = reader_get(r);
+        if (byte < 0) return false;
+        zigzag |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool replay_reader_next(ReplayReader *r, TiltInput *input) {
+    if (r->file == NULL) return false;
+    // Partida fechada: para no número de ticks gravado
+    if (r->header.ticks != 0 && r->ticks_read == r->header.ticks) return false;
+
+    if (r->repeat > 0) {
+        r->repeat--;
+    } else {
+        int control = reader_get(r);
+        if (control < 0) return false;
+
+        if (control & REPLAY_REPEAT_FLAG) {
+            r->repeat = (control & REPLAY_REPEAT_MAX) - 1;
+        } else {
+            int32_t delta;
+            r->last.dir_x = (int8_t)((control & 0x03) - 1);
+            r->last.dir_y = (int8_t)(((control >> 2) & 0x03) - 1);
+            if (control & REPLAY_X_CHANGED) {
+                if (!reader_get_delta(r, &delta)) return false;
+                r->last.x = (q15_t)(r->last.x + delta);
+            }
+            if (control & REPLAY_Y_CHANGED) {
+                if (!reader_get_delta(r, &delta)) return false;
+                r->last.y = (q15_t)(r->last.y + delta);
+            }
+        }
+    }
+
+    r->ticks_read++;
+    *input = r->last;
+    return true;
+}
+
+void replay_reader_close(ReplayReader *r) {
+    if (r->file != NULL) {
+        fclose(r->file);
+        r->file = NULL;
+    }
+}
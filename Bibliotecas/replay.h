@@ -0,0 +1,84 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "sdcard.h"
+#include "tilt.h"
+
+// Gravação de partidas: semente do gerador do jogo (rng.h) mais a entrada filtrada de cada
+// tick, para repetir a partida passando pelos mesmos *_update. Cada jogo
+// guarda só a última partida, em REPLAY_DIR/<jogo>.rpl.
+#define REPLAY_DIR MOUNT_POINT "/replays"
+#define REPLAY_MAGIC "RP"
+#define REPLAY_VERSION 4 // 1: semente ia para o srand(); 2: física em pixels inteiros; 3: Dodge a cada 300 ms
+
+// A gravação junta os ticks em RAM e entrega um bloco cheio por vez à
+// tarefa de gravação, que é a única a tocar no cartão. Com todos os blocos
+// ainda na fila (cartão atrasado), a gravação da partida é interrompida: o
+// jogo nunca espera o cartão.
+#define REPLAY_CHUNK 512
+#define REPLAY_BUFFERS 4
+
+// Tarefa de gravação: prioridade baixa, só acorda quando há bloco novo
+#define REPLAY_TASK_CORE 0
+#define REPLAY_TASK_PRIORITY 2
+
+// Cabeçalho; ticks e final_score são preenchidos ao fechar (0 = partida
+// interrompida, o leitor vai até o fim do arquivo)
+typedef struct {
+    char magic[2];
+    uint8_t version;
+    uint8_t game;            // GameSelection
+    uint32_t seed;
+    uint32_t ticks;
+    int32_t final_score;
+    uint16_t tick_ms;
+    uint16_t reserved;
+} ReplayHeader;
+
+// Codificação por tick: um byte de controle com as direções (2 bits cada) e
+// quais eixos mudaram, seguido da diferença de x/y em zigzag varint. Ticks
+// iguais ao anterior viram um byte de repetição (bit 7 + contagem).
+// Uma gravação por vez: os blocos são de replay.c.
+typedef struct {
+    bool active;
+    ReplayHeader header;
+    TiltInput last;
+    uint8_t repeat;
+    uint8_t chunk;           // bloco sendo preenchido
+    uint16_t used;
+    bool failed;
+} ReplayWriter;
+
+typedef struct {
+    FILE *file;
+    ReplayHeader header;
+    TiltInput last;
+    uint8_t repeat;
+    uint16_t used, pos;
+    uint32_t ticks_read;
+    uint8_t chunk[REPLAY_CHUNK];
+} ReplayReader;
+
+// Só preenchem a RAM e enfileiram pedidos; sem a tarefa, gravam na hora.
+// close retorna false se a gravação foi interrompida.
+bool replay_writer_open(ReplayWriter *w, const char *path, uint8_t game, uint32_t seed, uint16_t tick_ms);
+void replay_writer_tick(ReplayWriter *w, const TiltInput *input);
+bool replay_writer_close(ReplayWriter *w, int32_t final_score);
+
+bool replay_start_task(int core);
+
+// Espera a tarefa gravar tudo o que foi entregue (ex.: antes de dormir)
+void replay_flush();
+
+bool replay_reader_open(ReplayReader *r, const char *path);
+bool replay_reader_next(ReplayReader *r, TiltInput *input);
+void replay_reader_close(ReplayReader *r);
+
+// Caminho da última partida do jogo (nome como nos recordes)
+void replay_path(char *path, size_t size, const char *game_name);
+void replay_set_dir(const char *dir);
+
+#endif // REPLAY_H
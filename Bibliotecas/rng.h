@@ -0,0 +1,41 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Gerador pseudoaleatório por jogo (xorshift32). Cada jogo guarda o seu na
+// própria estrutura, então a sequência depende só da semente: a partida
+// gravada se repete igual e várias partidas podem rodar em paralelo no
+// host sem disputar o estado global do rand().
+typedef struct {
+    uint32_t state;
+} Rng;
+
+// Qualquer semente serve (inclusive 0 e sementes vizinhas): ela passa pelo
+// finalizador do murmur3 antes de virar estado
+static inline void rng_seed(Rng *rng, uint32_t seed) {
+    seed ^= seed >> 16;
+    seed *= 0x85EBCA6Bu;
+    seed ^= seed >> 13;
+    seed *= 0xC2B2AE35u;
+    seed ^= seed >> 16;
+    rng->state = seed ? seed : 0x6D2B79F5u; // xorshift não sai do zero
+}
+
+static inline uint32_t rng_next(Rng *rng) {
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->state = x;
+    return x;
+}
+
+// Inteiro em [0, bound): multiplicação de 32x32 -> 64 bits pegando a parte
+// alta, sem a divisão do "% bound" (e usando os bits altos, os melhores do
+// xorshift)
+static inline uint32_t rng_below(Rng *rng, uint32_t bound) {
+    return (uint32_t)(((uint64_t)rng_next(rng) * bound) >> 32);
+}
+
+#endif // RNG_H
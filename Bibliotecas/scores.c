@@ -0,0 +1,392 @@
+#include "scores.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
+
+static const char *TAG = "SCORES";
+
+#define SCORES_MAGIC "HS"
+#define SCORES_VERSION 2
+
+// Retrato da tabela (sem padding: 8 + 8 * 72 + 8 bytes)
+typedef struct {
+    char magic[2];
+    uint8_t version;
+    uint8_t count;
+    uint32_t last_seq;           // última partida incluída
+    GameScores games[SCORES_MAX_GAMES];
+    uint32_t crc;
+    uint32_t reserved;
+} ScoresSnapshot;
+
+// Uma partida no log; o CRC por registro descarta uma cauda cortada
+typedef struct {
+    uint32_t seq;
+    char name[SCORES_NAME_LEN];
+    int32_t score;
+    uint32_t duration_ms;
+    uint32_t crc;
+} ScoreRecord;
+
+// Versão 1: só o melhor de cada jogo
+typedef struct {
+    char name[SCORES_NAME_LEN];
+    int32_t score;
+} ScoreEntryV1;
+
+typedef struct {
+    char magic[2];
+    uint8_t version;
+    uint8_t count;
+    ScoreEntryV1 entries[SCORES_MAX_GAMES];
+    uint32_t crc;
+} ScoresFileV1;
+
+static const char *legacy_games[] = { "snake", "pong", "dodge", "tilt_maze" };
+
+// table e a fila de pendentes ficam sob table_lock; o cartão, sob io_lock
+static ScoresSnapshot table;
+static ScoreRecord pending[SCORES_PENDING];
+static int pending_count = 0;
+static bool compact_needed = false;
+static int log_records = 0;
+static SemaphoreHandle_t table_lock = NULL;
+static SemaphoreHandle_t io_lock = NULL;
+static SemaphoreHandle_t write_request = NULL;
+static TaskHandle_t writer_task = NULL;
+static char scores_dir[128] = SCORES_DIR;
+
+static void take(SemaphoreHandle_t sem) {
+    if (sem) xSemaphoreTake(sem, portMAX_DELAY);
+}
+
+static void give(SemaphoreHandle_t sem) {
+    if (sem) xSemaphoreGive(sem);
+}
+
+static void scores_path(char *path, size_t size, const char *file) {
+    snprintf(path, size, "%s/%s", scores_dir, file);
+}
+
+static uint32_t crc32(const void *data, size_t len) {
+    const uint8_t *bytes = data;
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+static void table_clear() {
+    memset(&table, 0, sizeof(table));
+    memcpy(table.magic, SCORES_MAGIC, 2);
+    table.version = SCORES_VERSION;
+}
+
+static GameScores *find_game(const char *game_name, bool create) {
+    for (int i = 0; i < table.count; i++) {
+        if (strncmp(table.games[i].name, game_name, SCORES_NAME_LEN) == 0) {
+            return &table.games[i];
+        }
+    }
+    if (!create || table.count == SCORES_MAX_GAMES) return NULL;
+
+    GameScores *game = &table.games[table.count++];
+    memset(game, 0, sizeof(*game));
+    strncpy(game->name, game_name, SCORES_NAME_LEN - 1);
+    return game;
+}
+
+// Insere mantendo a ordem decrescente; fora do top-N não entra
+static void insert_top(GameScores *game, int32_t score) {
+    int pos = game->top_count;
+    if (pos == SCORES_TOP_N) {
+        if (score <= game->top[SCORES_TOP_N - 1]) return;
+        pos--;
+    } else {
+        game->top_count++;
+    }
+    while (pos > 0 && game->top[pos - 1] < score) {
+        game->top[pos] = game->top[pos - 1];
+        pos--;
+    }
+    game->top[pos] = score;
+}
+
+static bool apply_game(const char *game_name, int32_t score, uint32_t duration_ms) {
+    GameScores *game = find_game(game_name, true);
+    if (game == NULL) return false;
+
+    bool new_record = score > (game->top_count ? game->top[0] : 0);
+    insert_top(game, score);
+    game->games_played++;
+    game->score_sum += score;
+    if (duration_ms > game->longest_run_ms) game->longest_run_ms = duration_ms;
+    return new_record;
+}
+
+static bool load_v1(const ScoresFileV1 *file) {
+    if (file->count > SCORES_MAX_GAMES ||
+        file->crc != crc32(file, offsetof(ScoresFileV1, crc))) {
+        return false;
+    }
+    table_clear();
+    for (int i = 0; i < file->count; i++) {
+        GameScores *game = find_game(file->entries[i].name, true);
+        insert_top(game, file->entries[i].score);
+    }
+    compact_needed = true;
+    return true;
+}
+
+static bool load_snapshot(const char *file) {
+    static ScoresSnapshot image;
+    char path[160];
+
+    scores_path(path, sizeof(path), file);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return false;
+    size_t n = fread(&image, 1, sizeof(image), f);
+    fclose(f);
+
+    bool ok = false;
+    if (n >= 4 && memcmp(image.magic, SCORES_MAGIC, 2) == 0) {
+        if (image.version == 1 && n == sizeof(ScoresFileV1)) {
+            ok = load_v1((const ScoresFileV1 *)&image);
+        } else if (image.version == SCORES_VERSION && n == sizeof(image) &&
+                   image.count <= SCORES_MAX_GAMES &&
+                   image.crc == crc32(&image, offsetof(ScoresSnapshot, crc))) {
+            table = image;
+            ok = true;
+        }
+    }
+    if (!ok) {
+        ESP_LOGE(TAG, "Arquivo de recordes inválido: %s", path);
+    }
+    return ok;
+}
+
+// Reaplica as partidas posteriores ao retrato. Um registro cortado (falta de
+// energia no meio do acréscimo) encerra a leitura e força a compactação,
+// senão os acréscimos seguintes ficariam atrás dele.
+static void replay_log() {
+    char path[160];
+    ScoreRecord record;
+
+    scores_path(path, sizeof(path), "scores.log");
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return;
+
+    bool torn = false;
+    size_t n;
+    while ((n = fread(&record, 1, sizeof(record), f)) == sizeof(record)) {
+        if (record.crc != crc32(&record, offsetof(ScoreRecord, crc))) {
+            torn = true;
+            break;
+        }
+        log_records++;
+        if (record.seq <= table.last_seq) continue;
+        record.name[SCORES_NAME_LEN - 1] = '\0';
+        apply_game(record.name, record.score, record.duration_ms);
+        table.last_seq = record.seq;
+    }
+    fclose(f);
+
+    if (torn || n != 0) {
+        ESP_LOGE(TAG, "Log de recordes com registro incompleto, compactando");
+        compact_needed = true;
+    }
+}
+
+void scores_set_dir(const char *dir) {
+    snprintf(scores_dir, sizeof(scores_dir), "%s", dir);
+}
+
+void scores_init() {
+    if (table_lock == NULL) {
+        table_lock = xSemaphoreCreateMutex();
+        io_lock = xSemaphoreCreateMutex();
+    }
+
+    table_clear();
+    pending_count = 0;
+    log_records = 0;
+    compact_needed = false;
+    if (!sd_card_initialized) return;
+
+    // Se faltou energia entre o remove e o rename da compactação, o
+    // temporário já está completo
+    if (!load_snapshot("scores.bin") && !load_snapshot("scores.tmp")) {
+        table_clear();
+        // Primeiro boot com a tabela: importa os arquivos de texto por jogo
+        for (size_t i = 0; i < sizeof(legacy_games) / sizeof(legacy_games[0]); i++) {
+            int score = read_high_score(legacy_games[i]);
+            if (score > 0) {
+                insert_top(find_game(legacy_games[i], true), score);
+                compact_needed = true;
+            }
+        }
+    }
+    replay_log();
+}
+
+int scores_get(const char *game_name) {
+    take(table_lock);
+    const GameScores *game = find_game(game_name, false);
+    int score = (game && game->top_count) ? game->top[0] : 0;
+    give(table_lock);
+    return score;
+}
+
+bool scores_get_board(const char *game_name, GameScores *board) {
+    take(table_lock);
+    const GameScores *game = find_game(game_name, false);
+    if (game) {
+        *board = *game;
+    } else {
+        memset(board, 0, sizeof(*board));
+        strncpy(board->name, game_name, SCORES_NAME_LEN - 1);
+    }
+    give(table_lock);
+    return game != NULL;
+}
+
+// Acrescenta as partidas pendentes no fim do log (chamada com io_lock)
+static void append_pending() {
+    ScoreRecord batch[SCORES_PENDING];
+    char path[160];
+
+    take(table_lock);
+    int count = pending_count;
+    memcpy(batch, pending, count * sizeof(ScoreRecord));
+    pending_count = 0;
+    give(table_lock);
+    if (count == 0) return;
+
+    scores_path(path, sizeof(path), "scores.log");
+    FILE *f = fopen(path, "ab");
+    bool ok = f != NULL && fwrite(batch, sizeof(ScoreRecord), count, f) == (size_t)count;
+    if (f != NULL && fclose(f) != 0) ok = false;
+
+    if (ok) {
+        log_records += count;
+    } else {
+        ESP_LOGE(TAG, "Falha ao acrescentar no log de recordes");
+        take(table_lock);
+        compact_needed = true;
+        give(table_lock);
+    }
+}
+
+// Grava o retrato da RAM e apaga o log (chamada com io_lock). O retrato
+// cobre também as pendentes, que deixam de ir para o log.
+static void compact() {
+    static ScoresSnapshot image;
+    char path[160], temp[160], log_path[160];
+
+    take(table_lock);
+    table.crc = crc32(&table, offsetof(ScoresSnapshot, crc));
+    image = table;
+    pending_count = 0;
+    compact_needed = false;
+    give(table_lock);
+
+    scores_path(path, sizeof(path), "scores.bin");
+    scores_path(temp, sizeof(temp), "scores.tmp");
+    scores_path(log_path, sizeof(log_path), "scores.log");
+
+    FILE *f = fopen(temp, "wb");
+    bool ok = f != NULL && fwrite(&image, 1, sizeof(image), f) == sizeof(image);
+    if (f != NULL && fclose(f) != 0) ok = false;
+
+    // O rename do FAT não substitui um arquivo existente
+    if (ok) {
+        remove(path);
+        ok = rename(temp, path) == 0;
+    }
+    if (ok) {
+        // Os registros que sobrarem no log têm seq <= last_seq e são ignorados
+        remove(log_path);
+        log_records = 0;
+    } else {
+        ESP_LOGE(TAG, "Falha ao gravar os recordes em %s", path);
+        take(table_lock);
+        compact_needed = true;
+        give(table_lock);
+    }
+}
+
+static void write_behind(bool force_compact) {
+    if (!sd_card_initialized) return;
+
+    take(io_lock);
+    append_pending();
+    take(table_lock);
+    bool needs = compact_needed;
+    give(table_lock);
+    if (force_compact || needs || log_records >= SCORES_COMPACT_RECORDS) {
+        compact();
+    }
+    give(io_lock);
+}
+
+void scores_flush() {
+    write_behind(true);
+}
+
+bool scores_submit(const char *game_name, int score, uint32_t duration_ms) {
+    take(table_lock);
+    bool new_record = apply_game(game_name, score, duration_ms);
+    table.last_seq++;
+    if (pending_count < SCORES_PENDING) {
+        ScoreRecord *record = &pending[pending_count++];
+        memset(record, 0, sizeof(*record));
+        record->seq = table.last_seq;
+        strncpy(record->name, game_name, SCORES_NAME_LEN - 1);
+        record->score = score;
+        record->duration_ms = duration_ms;
+        record->crc = crc32(record, offsetof(ScoreRecord, crc));
+    } else {
+        compact_needed = true;
+    }
+    give(table_lock);
+
+    if (writer_task != NULL) {
+        xSemaphoreGive(write_request);
+    } else {
+        write_behind(false);
+    }
+    return new_record;
+}
+
+static void scores_task(void *pvParameters) {
+    while (1) {
+        xSemaphoreTake(write_request, portMAX_DELAY);
+        write_behind(false);
+    }
+}
+
+bool scores_start_task(int core) {
+    if (writer_task != NULL) return true;
+
+    write_request = xSemaphoreCreateBinary();
+    if (write_request == NULL ||
+        xTaskCreatePinnedToCore(scores_task, "scores", 3072, NULL, SCORES_TASK_PRIORITY,
+                                &writer_task, core) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar a tarefa de recordes, gravando na hora");
+        writer_task = NULL;
+        return false;
+    }
+
+    // Importação ou log cortado ainda não gravados
+    if (compact_needed) xSemaphoreGive(write_request);
+    return true;
+}
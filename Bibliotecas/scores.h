@@ -0,0 +1,56 @@
+#ifndef SCORES_H
+#define SCORES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sdcard.h"
+
+// Recordes e estatísticas por jogo, indexados em RAM. No cartão ficam um
+// retrato da tabela (scores.bin, com CRC, trocado por arquivo temporário +
+// rename) e um log só de acréscimo com as partidas depois dele (scores.log).
+// O boot lê o retrato e reaplica o log; a tarefa de gravação acrescenta as
+// partidas novas e compacta o log no retrato quando ele cresce.
+#define SCORES_DIR MOUNT_POINT
+#define SCORES_MAX_GAMES 8
+#define SCORES_NAME_LEN 12
+#define SCORES_TOP_N 10
+
+// Partidas no log que disparam a compactação
+#define SCORES_COMPACT_RECORDS 64
+
+// Partidas esperando a tarefa; com a fila cheia o registro no log é
+// descartado (a RAM já tem o resultado, e a próxima compactação o grava)
+#define SCORES_PENDING 8
+
+// Tarefa de gravação: prioridade baixa, só acorda quando há partida nova
+#define SCORES_TASK_CORE 0
+#define SCORES_TASK_PRIORITY 2
+
+typedef struct {
+    char name[SCORES_NAME_LEN];
+    int32_t top[SCORES_TOP_N];   // decrescente
+    uint32_t games_played;
+    uint32_t longest_run_ms;     // partida mais longa
+    uint8_t top_count;
+    uint8_t reserved[3];
+    int64_t score_sum;           // para a média
+} GameScores;
+
+// Carrega o retrato e reaplica o log (sem eles, importa os recordes antigos)
+void scores_init();
+bool scores_start_task(int core);
+
+// Leituras só na RAM
+int scores_get(const char *game_name);
+bool scores_get_board(const char *game_name, GameScores *board);
+
+// Registra uma partida: O(SCORES_TOP_N) na RAM e uma cópia para a fila da
+// tarefa, sem tocar no cartão. Retorna true se for recorde novo.
+bool scores_submit(const char *game_name, int score, uint32_t duration_ms);
+
+// Grava agora o que estiver pendente e compacta (ex.: antes de desligar)
+void scores_flush();
+
+void scores_set_dir(const char *dir);
+
+#endif // SCORES_H
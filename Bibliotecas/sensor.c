@@ -0,0 +1,286 @@
+#include "sensor.h"
+#include "mpu6050.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+static const char *TAG = "SENSOR";
+
+static bool fifo_enabled = false;
+static TaskHandle_t sensor_task = NULL;
+static SemaphoreHandle_t data_ready = NULL;
+
+// Estado do filtro: só quem produz as amostras mexe (a tarefa, ou o próprio
+// jogo quando não há tarefa)
+static TiltPipeline pipeline;
+static TiltCalibration calibration;
+static uint32_t filter_generation = 0;
+
+// sensor_reset() pede uma geração nova; a tarefa a adota quando de fato zera
+// o filtro e marca as amostras com ela. Uma amostra que já estava sendo
+// lida no pedido sai com a geração antiga e o consumidor a descarta.
+static atomic_uint requested_generation = 0;
+static char calib_path[128] = SENSOR_CALIB_FILE;
+
+// Fila SPSC: só a tarefa escreve ring_head, só o consumidor escreve ring_tail.
+// O consumidor só quer a amostra mais nova, então a tarefa nunca espera nem
+// descarta: cheia (pausa entre níveis, tela de fim de jogo), a amostra nova
+// sobrescreve a mais antiga. A mais nova fica em head - 1, longe da posição
+// que está sendo escrita.
+static TiltSample ring[SENSOR_RING_SIZE];
+static atomic_uint ring_head = 0;
+static atomic_uint ring_tail = 0;
+
+static void ring_push(const TiltSample *sample) {
+    unsigned head = atomic_load_explicit(&ring_head, memory_order_relaxed);
+    ring[head & (SENSOR_RING_SIZE - 1)] = *sample;
+    atomic_store_explicit(&ring_head, head + 1, memory_order_release);
+}
+
+// Esvazia a fila ficando só com a amostra mais nova
+static bool ring_pop_latest(TiltSample *sample) {
+    unsigned tail = atomic_load_explicit(&ring_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&ring_head, memory_order_acquire);
+
+    if (head == tail) return false;
+    *sample = ring[(head - 1) & (SENSOR_RING_SIZE - 1)];
+    atomic_store_explicit(&ring_tail, head, memory_order_release);
+    return true;
+}
+
+// Lê tudo que o sensor mediu desde a última vez e passa pelo filtro.
+// Retorna false se não havia amostra nova.
+static bool sensor_acquire(TiltSample *sample) {
+    if (fifo_enabled) {
+        static Mpu6050Sample batch[MPU6050_FIFO_MAX_BATCH];
+        int n = mpu6050_fifo_read(batch, MPU6050_FIFO_MAX_BATCH);
+        if (n == 0) return false;
+        for (int i = 0; i < n; i++) {
+            const int16_t accel[3] = { batch[i].ax, batch[i].ay, batch[i].az };
+            const int16_t gyro[3] = { batch[i].gx, batch[i].gy, batch[i].gz };
+            tilt_pipeline_push(&pipeline, accel, gyro);
+        }
+    } else {
+        // Leitura direta: só o acelerômetro, o filtro vira um passa-baixa
+        int16_t accel[3];
+        if (!mpu6050_read_accel_locked(&accel[0], &accel[1], &accel[2])) return false;
+        tilt_pipeline_push(&pipeline, accel, NULL);
+    }
+
+    tilt_pipeline_output(&pipeline, &sample->input);
+    sample->timestamp_us = esp_timer_get_time();
+    sample->generation = filter_generation;
+    return true;
+}
+
+static void reset_filter() {
+    tilt_pipeline_reset(&pipeline);
+    if (fifo_enabled) {
+        mpu6050_fifo_reset();
+    }
+}
+
+static void IRAM_ATTR data_ready_isr(void *arg) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(data_ready, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void sensor_task_fn(void *pvParameters) {
+    TiltSample sample;
+
+    while (1) {
+        // O timeout cobre uma interrupção perdida: o FIFO guarda as amostras
+        xSemaphoreTake(data_ready, pdMS_TO_TICKS(100));
+
+        unsigned generation = atomic_load(&requested_generation);
+        if (generation != filter_generation) {
+            reset_filter();
+            filter_generation = generation;
+            continue;
+        }
+        if (sensor_acquire(&sample)) {
+            ring_push(&sample);
+        }
+    }
+}
+
+bool sensor_init() {
+    fifo_enabled = mpu6050_fifo_start(SENSOR_SAMPLE_RATE_HZ);
+    if (fifo_enabled) {
+        tilt_pipeline_init(&pipeline, TILT_ALPHA_FIFO, SENSOR_SAMPLE_RATE_HZ);
+    } else {
+        tilt_pipeline_init(&pipeline, TILT_ALPHA_FRAME, 0);
+    }
+    if (!fifo_enabled) {
+        ESP_LOGE(TAG, "FIFO do MPU6050 indisponível, usando leitura direta por quadro");
+    }
+    return fifo_enabled;
+}
+
+// Junta SENSOR_CALIB_SAMPLES amostras brutas (sem giroscópio na leitura direta)
+static void collect_calibration_samples(int32_t sum[6], int16_t min[6], int16_t max[6]) {
+    static Mpu6050Sample batch[MPU6050_FIFO_MAX_BATCH];
+    int collected = 0;
+
+    for (int axis = 0; axis < 6; axis++) {
+        sum[axis] = 0;
+        min[axis] = INT16_MAX;
+        max[axis] = INT16_MIN;
+    }
+    if (fifo_enabled) {
+        mpu6050_fifo_reset();
+    }
+
+    while (collected < SENSOR_CALIB_SAMPLES) {
+        int n = 1;
+        if (fifo_enabled) {
+            vTaskDelay(pdMS_TO_TICKS(50));
+            n = mpu6050_fifo_read(batch, MPU6050_FIFO_MAX_BATCH);
+        } else {
+            vTaskDelay(1);
+            batch[0] = (Mpu6050Sample){ 0 };
+            if (!mpu6050_read_accel_locked(&batch[0].ax, &batch[0].ay, &batch[0].az)) n = 0;
+        }
+
+        for (int i = 0; i < n && collected < SENSOR_CALIB_SAMPLES; i++, collected++) {
+            const int16_t v[6] = { batch[i].ax, batch[i].ay, batch[i].az,
+                                   batch[i].gx, batch[i].gy, batch[i].gz };
+            for (int axis = 0; axis < 6; axis++) {
+                sum[axis] += v[axis];
+                if (v[axis] < min[axis]) min[axis] = v[axis];
+                if (v[axis] > max[axis]) max[axis] = v[axis];
+            }
+        }
+    }
+}
+
+bool sensor_calibrate() {
+    int32_t sum[6];
+    int16_t min[6], max[6];
+
+    for (int attempt = 0; attempt < SENSOR_CALIB_ATTEMPTS; attempt++) {
+        collect_calibration_samples(sum, min, max);
+
+        bool moving = false;
+        for (int axis = 0; axis < 6; axis++) {
+            int limit = (axis < 3) ? SENSOR_CALIB_MAX_ACCEL_SPREAD : SENSOR_CALIB_MAX_GYRO_SPREAD;
+            if (max[axis] - min[axis] > limit) moving = true;
+        }
+        if (moving) {
+            ESP_LOGE(TAG, "Sensor se moveu durante a calibração (tentativa %d)", attempt + 1);
+            continue;
+        }
+
+        for (int axis = 0; axis < 3; axis++) {
+            calibration.accel[axis] = sum[axis] / SENSOR_CALIB_SAMPLES;
+            calibration.gyro[axis] = sum[axis + 3] / SENSOR_CALIB_SAMPLES;
+        }
+        // Em repouso na horizontal o eixo z mede 1 g
+        calibration.accel[2] -= 16384;
+
+        tilt_pipeline_set_calibration(&pipeline, &calibration);
+        reset_filter();
+        ESP_LOGI(TAG, "Calibrado: accel %d %d %d, gyro %d %d %d",
+                 calibration.accel[0], calibration.accel[1], calibration.accel[2],
+                 calibration.gyro[0], calibration.gyro[1], calibration.gyro[2]);
+        return true;
+    }
+    return false;
+}
+
+void sensor_set_calibration_path(const char *path) {
+    snprintf(calib_path, sizeof(calib_path), "%s", path);
+}
+
+bool sensor_load_calibration() {
+    if (!sd_card_initialized) return false;
+
+    FILE *f = fopen(calib_path, "r");
+    if (f == NULL) return false;
+
+    int v[6];
+    int fields = fscanf(f, "%d %d %d %d %d %d", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]);
+    fclose(f);
+    if (fields != 6) {
+        ESP_LOGE(TAG, "Arquivo de calibração inválido: %s", calib_path);
+        return false;
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        calibration.accel[axis] = v[axis];
+        calibration.gyro[axis] = v[axis + 3];
+    }
+    tilt_pipeline_set_calibration(&pipeline, &calibration);
+    return true;
+}
+
+bool sensor_save_calibration() {
+    if (!sd_card_initialized) return false;
+
+    FILE *f = fopen(calib_path, "w");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "Falha ao salvar a calibração em %s", calib_path);
+        return false;
+    }
+    fprintf(f, "%d %d %d %d %d %d\n",
+            calibration.accel[0], calibration.accel[1], calibration.accel[2],
+            calibration.gyro[0], calibration.gyro[1], calibration.gyro[2]);
+    fclose(f);
+    return true;
+}
+
+bool sensor_start_task(int core) {
+    if (sensor_task != NULL) return true;
+    if (!fifo_enabled) return false;
+
+    data_ready = xSemaphoreCreateBinary();
+    gpio_set_direction(MPU6050_INT_PIN, GPIO_MODE_INPUT);
+    gpio_set_intr_type(MPU6050_INT_PIN, GPIO_INTR_POSEDGE);
+    gpio_install_isr_service(0);
+    if (gpio_isr_handler_add(MPU6050_INT_PIN, data_ready_isr, NULL) != ESP_OK ||
+        !mpu6050_enable_data_ready_int()) {
+        ESP_LOGE(TAG, "Sem interrupção do sensor, lendo a cada quadro");
+        return false;
+    }
+
+    if (xTaskCreatePinnedToCore(sensor_task_fn, "sensor", 3072, NULL,
+                                SENSOR_TASK_PRIORITY, &sensor_task, core) != pdPASS) {
+        ESP_LOGE(TAG, "Falha ao criar a tarefa do sensor");
+        gpio_isr_handler_remove(MPU6050_INT_PIN);
+        sensor_task = NULL;
+        return false;
+    }
+    return true;
+}
+
+void sensor_reset() {
+    if (sensor_task == NULL) {
+        reset_filter();
+        return;
+    }
+    atomic_fetch_add(&requested_generation, 1);
+}
+
+bool sensor_read(TiltSample *sample) {
+    TiltSample latest;
+
+    if (sensor_task == NULL) {
+        return sensor_acquire(sample);
+    }
+    if (!ring_pop_latest(&latest) ||
+        latest.generation != atomic_load_explicit(&requested_generation, memory_order_relaxed)) {
+        return false;
+    }
+    *sample = latest;
+    return true;
+}
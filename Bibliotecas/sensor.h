@@ -0,0 +1,57 @@
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sdcard.h"
+#include "tilt.h"
+
+// Aquisição do MPU6050: FIFO a 200 Hz drenado pela tarefa do sensor a cada
+// interrupção de dado pronto; cada amostra passa pelo pipeline de tilt.h
+#define SENSOR_SAMPLE_RATE_HZ 200
+
+// Tarefa do sensor: mesmo núcleo do envio do display, prioridade maior
+#define SENSOR_TASK_CORE 0
+#define SENSOR_TASK_PRIORITY 7
+
+// Fila produtor/consumidor sem trava entre a tarefa e o jogo (potência de 2)
+#define SENSOR_RING_SIZE 16
+
+// Calibração: média de 1 s parado; refaz se o giroscópio variar mais de
+// 2 graus/s ou o acelerômetro mais de 0.05 g durante a medida
+#define SENSOR_CALIB_SAMPLES 200
+#define SENSOR_CALIB_ATTEMPTS 3
+#define SENSOR_CALIB_MAX_GYRO_SPREAD 262
+#define SENSOR_CALIB_MAX_ACCEL_SPREAD 820
+#define SENSOR_CALIB_FILE MOUNT_POINT "/calib.txt"
+
+typedef struct {
+    TiltInput input;
+    int64_t timestamp_us;
+    uint32_t generation;     // sensor_reset() atendido quando foi filtrada
+} TiltSample;
+
+// Liga o FIFO do sensor. Sem ele cada leitura é direta, uma por quadro.
+bool sensor_init();
+
+// Offsets do sensor. sensor_calibrate() mede com o aparelho parado e na
+// horizontal (tela para cima) e deve rodar antes de sensor_start_task().
+// O arquivo no cartão é texto: "ax ay az gx gy gz".
+bool sensor_calibrate();
+bool sensor_load_calibration();
+bool sensor_save_calibration();
+void sensor_set_calibration_path(const char *path);
+
+// Liga a interrupção de dado pronto e cria a tarefa do sensor. Se falhar,
+// sensor_read() continua funcionando lendo o sensor na hora.
+bool sensor_start_task(int core);
+
+// Zera o filtro e descarta amostras antigas (início de jogo). Com a tarefa,
+// sensor_read() ignora tudo o que ela filtrou antes de atender o pedido.
+void sensor_reset();
+
+// Não bloqueia: copia a amostra mais nova publicada desde a última chamada.
+// Retorna false se não chegou nada novo (sample fica como estava).
+bool sensor_read(TiltSample *sample);
+
+#endif // SENSOR_H
@@ -0,0 +1,132 @@
+#include "tilt.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void tilt_pipeline_init(TiltPipeline *p, q15_t alpha, int sample_rate_hz) {
+    memset(&p->cal, 0, sizeof(p->cal));
+    p->alpha = alpha;
+    p->gyro_scale = 0;
+    if (sample_rate_hz > 0) {
+        // graus/s -> fração de 90 graus avançada em uma amostra, em Q30
+        p->gyro_scale = (int32_t)((double)(1 << 30) / (TILT_GYRO_LSB_PER_DPS * 90.0 * sample_rate_hz));
+    }
+    p->release = TILT_RELEASE;
+    tilt_pipeline_reset(p);
+}
+
+void tilt_pipeline_set_calibration(TiltPipeline *p, const TiltCalibration *cal) {
+    p->cal = *cal;
+}
+
+void tilt_pipeline_reset(TiltPipeline *p) {
+    p->state_x = 0;
+    p->state_y = 0;
+    p->dir_x = 0;
+    p->dir_y = 0;
+}
+
+static uint32_t isqrt32(uint32_t v) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v) bit >>= 2;
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// atan2(y, x) para x >= 0, em Q30 de 90 graus. Reduz ao octante |z| <= 1 e
+// usa atan(z) ~ z/2 + 0.1738 z (1 - z) (em unidades de 90 graus), erro
+// máximo de ~0.2 grau
+static int32_t atan2_q30(int32_t y, uint32_t x) {
+    uint32_t mag = abs(y);
+    if (mag == 0 && x == 0) return 0;
+
+    bool swap = mag > x;
+    uint32_t num = swap ? x : mag;
+    uint32_t den = swap ? mag : x;
+    int32_t z = (int32_t)((num << 15) / den);   // num <= |a| < 2^16
+    int32_t a = z / 2 + (int32_t)(((int64_t)5695 * z * (Q15_ONE - z)) >> 30);
+    if (swap) a = Q15_ONE - a;
+
+    a *= 1 << 15;
+    return (y < 0) ? -a : a;
+}
+
+// state += alpha * (target - state); a diferença cabe em 32 bits (ângulos
+// dentro de +-90 graus), só o produto usa 64
+static inline int32_t blend(int32_t state, int32_t target, q15_t alpha) {
+    int32_t diff = target - state;
+    return state + (int32_t)(((int64_t)diff * alpha) >> 15);
+}
+
+static inline int32_t clamp_angle(int32_t v) {
+    if (v > (1 << 30)) return 1 << 30;
+    if (v < -(1 << 30)) return -(1 << 30);
+    return v;
+}
+
+void tilt_pipeline_push(TiltPipeline *p, const int16_t accel[3], const int16_t gyro[3]) {
+    int32_t ax = accel[0] - p->cal.accel[0];
+    int32_t ay = accel[1] - p->cal.accel[1];
+    int32_t az = accel[2] - p->cal.accel[2];
+
+    // Inclinação de cada eixo em relação ao plano (asin(a / |a|)), o que
+    // independe do módulo da aceleração
+    int32_t angle_x = atan2_q30(ax, isqrt32((uint32_t)(ay * ay) + (uint32_t)(az * az)));
+    int32_t angle_y = atan2_q30(ay, isqrt32((uint32_t)(ax * ax) + (uint32_t)(az * az)));
+
+    // Filtro complementar: o giroscópio move o ângulo na hora e o
+    // acelerômetro corrige a deriva devagar. Girar em +y inclina para -x.
+    if (gyro != NULL && p->gyro_scale != 0) {
+        p->state_x = clamp_angle(p->state_x - (gyro[1] - p->cal.gyro[1]) * p->gyro_scale);
+        p->state_y = clamp_angle(p->state_y + (gyro[0] - p->cal.gyro[0]) * p->gyro_scale);
+    }
+    p->state_x = blend(p->state_x, angle_x, p->alpha);
+    p->state_y = blend(p->state_y, angle_y, p->alpha);
+
+    // Decisões no estado em Q30: o limiar fica exato, sem o arredondamento
+    // para Q15
+    int32_t x = p->state_x;
+    int32_t y = p->state_y;
+    int32_t mag_x = abs(x);
+    int32_t mag_y = abs(y);
+
+    // Passou do limiar: mesma regra de sempre, vale o eixo dominante
+    if (mag_x > TILT_THRESHOLD || mag_y > TILT_THRESHOLD) {
+        if (mag_x > mag_y) {
+            p->dir_x = (x > 0) ? 1 : -1;
+            p->dir_y = 0;
+        } else {
+            p->dir_x = 0;
+            p->dir_y = (y > 0) ? 1 : -1;
+        }
+        return;
+    }
+
+    // Abaixo do limiar: a direção ativa se mantém até cair abaixo da soltura
+    if (p->dir_x != 0 && x * p->dir_x > p->release) return;
+    if (p->dir_y != 0 && y * p->dir_y > p->release) return;
+    p->dir_x = 0;
+    p->dir_y = 0;
+}
+
+static inline q15_t dead_zone(int32_t v) {
+    if (abs(v) < TILT_DEAD_ZONE) return 0;
+    return (v > INT16_MAX) ? INT16_MAX : (q15_t)v;
+}
+
+void tilt_pipeline_output(const TiltPipeline *p, TiltInput *out) {
+    out->x = dead_zone(p->state_x >> 15);
+    out->y = dead_zone(p->state_y >> 15);
+    out->dir_x = p->dir_x;
+    out->dir_y = p->dir_y;
+}
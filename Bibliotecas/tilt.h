@@ -0,0 +1,66 @@
+#ifndef TILT_H
+#define TILT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Pipeline de inclinação em ponto fixo, comum aos quatro jogos:
+// bruto do MPU6050 -> calibração -> ângulos de inclinação -> filtro
+// complementar com o giroscópio (ou só passa-baixa, sem ele) -> zona morta /
+// histerese. Ângulos em Q15/Q30 com 1.0 = 90 graus.
+typedef int16_t q15_t;
+
+#define Q15_ONE 32768
+#define Q15(x) ((q15_t)((x) * Q15_ONE))
+#define Q30(x) ((int32_t)((x) * (1 << 30)))
+#define TILT_DEG_Q15(d) Q15((d) / 90.0)
+#define TILT_DEG_Q30(d) Q30((d) / 90.0)
+
+// Limiares das direções em Q30, comparados direto com o estado do filtro.
+// 17.46 graus = asin(0.3): o mesmo ponto do antigo limiar de 0.3 g.
+#define TILT_THRESHOLD TILT_DEG_Q30(17.46)   // inclinação mínima para virar/mover
+#define TILT_RELEASE TILT_DEG_Q30(14.48)     // direção ativa só solta abaixo (0.25 g)
+#define TILT_DEAD_ZONE TILT_DEG_Q15(1.0)     // ruído em repouso nas leituras analógicas
+
+// Peso do acelerômetro por amostra: 0.2 por quadro com uma leitura direta por
+// quadro; 0.025 por amostra a 200 Hz, com o giroscópio cobrindo o curto prazo
+#define TILT_ALPHA_FRAME Q15(0.2)
+#define TILT_ALPHA_FIFO Q15(0.025)
+
+// Sensibilidade do giroscópio na faixa de +-250 graus/s
+#define TILT_GYRO_LSB_PER_DPS 131
+
+// Entrada dos jogos
+typedef struct {
+    q15_t x, y;          // inclinação (1.0 = 90 graus), já com zona morta
+    int8_t dir_x, dir_y; // direção -1/0/1 no eixo dominante (no máximo um != 0)
+} TiltInput;
+
+// Offsets medidos com o aparelho parado (ver sensor_calibrate())
+typedef struct {
+    int16_t accel[3];    // o eixo z fica com 1 g (16384) em repouso
+    int16_t gyro[3];
+} TiltCalibration;
+
+typedef struct {
+    TiltCalibration cal;
+    q15_t alpha;                 // peso do acelerômetro por amostra
+    int32_t gyro_scale;          // Q30 por LSB do giroscópio, por amostra
+    int32_t release;             // limiar de soltura em Q30 (TILT_THRESHOLD = sem histerese)
+    int32_t state_x, state_y;    // ângulos filtrados em Q30
+    int8_t dir_x, dir_y;
+} TiltPipeline;
+
+// sample_rate_hz: taxa das amostras com giroscópio (0 = só acelerômetro)
+void tilt_pipeline_init(TiltPipeline *p, q15_t alpha, int sample_rate_hz);
+void tilt_pipeline_set_calibration(TiltPipeline *p, const TiltCalibration *cal);
+
+// Zera o filtro e a direção (mantém calibração e coeficientes)
+void tilt_pipeline_reset(TiltPipeline *p);
+
+// Uma amostra bruta (16384 = 1 g, 131 = 1 grau/s); gyro pode ser NULL
+void tilt_pipeline_push(TiltPipeline *p, const int16_t accel[3], const int16_t gyro[3]);
+
+void tilt_pipeline_output(const TiltPipeline *p, TiltInput *out);
+
+#endif // TILT_H
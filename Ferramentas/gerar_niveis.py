@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Gera as tabelas de níveis do Tilt Maze a partir dos desenhos em niveis/.
+
+Cada nivel_N.txt tem 64 linhas de 128 caracteres (linhas iniciadas por ';'
+são comentários): '#' parede, '.' livre, 'P' início do jogador, 'C' comida
+(até 4) e '@' jogador começando sobre uma comida. A grade vai para o layout do display_buffer (páginas de 8 linhas,
+bit 0 em cima) e é comprimida em pares (repetições, byte).
+
+Uso:
+    python3 Ferramentas/gerar_niveis.py                 # gera Bibliotecas/maze_levels_data.h
+    python3 Ferramentas/gerar_niveis.py --bin saida/    # também gera nivel_NN.bin para /sdcard/niveis
+    python3 Ferramentas/gerar_niveis.py --primeiro 6 --bin saida/ extra/*.txt
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+WIDTH = 128
+HEIGHT = 64
+PAGES = HEIGHT // 8
+MAX_FOODS = 4
+BIN_MAGIC = b"MZ\x01"
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def parse_level(path):
+    rows = []
+    comment = ""
+    with open(path, encoding="utf-8") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith(";"):
+                comment = comment or line[1:].strip()
+                continue
+            if line:
+                rows.append(line)
+
+    if len(rows) != HEIGHT or any(len(r) != WIDTH for r in rows):
+        sys.exit(f"{path}: esperado {HEIGHT} linhas de {WIDTH} caracteres")
+
+    grid = bytearray(WIDTH * PAGES)
+    spawn = None
+    foods = []
+    for y, row in enumerate(rows):
+        for x, c in enumerate(row):
+            if c not in ".#PC@":
+                sys.exit(f"{path}:{y + 1}: caractere inválido {c!r}")
+            if c == "#":
+                grid[x + (y // 8) * WIDTH] |= 1 << (y % 8)
+            if c in "P@":
+                spawn = (x, y)
+            if c in "C@":
+                foods.append((x, y))
+
+    if spawn is None:
+        sys.exit(f"{path}: falta o início do jogador (P)")
+    if not 1 <= len(foods) <= MAX_FOODS:
+        sys.exit(f"{path}: são necessárias de 1 a {MAX_FOODS} comidas (C)")
+    return comment, spawn, foods, grid
+
+
+def rle_encode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 255 and data[i + run] == data[i]:
+            run += 1
+        out += bytes((run, data[i]))
+        i += run
+    return out
+
+
+def level_number(path):
+    m = re.search(r"(\d+)", os.path.basename(path))
+    return int(m.group(1)) if m else 0
+
+
+def c_bytes(data, indent="    "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02X}" for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def write_header(levels, path):
+    out = [
+        "// Gerado por Ferramentas/gerar_niveis.py a partir de Ferramentas/niveis/.",
+        "// Não edite à mão: altere os desenhos e gere de novo.",
+        "#ifndef MAZE_LEVELS_DATA_H",
+        "#define MAZE_LEVELS_DATA_H",
+        "",
+        '#include "maze_levels.h"',
+        "",
+    ]
+    for n, (comment, _, _, grid) in enumerate(levels, 1):
+        rle = rle_encode(grid)
+        out.append(f"// Nível {n}: {comment} ({len(rle)} bytes)")
+        out.append(f"static const uint8_t maze_level_{n}_rle[] = {{")
+        out.append(c_bytes(rle))
+        out.append("};")
+        out.append("")
+
+    out.append(f"#define MAZE_BUILTIN_LEVELS {len(levels)}")
+    out.append("")
+    out.append("static const MazeLevelDesc maze_builtin_levels[MAZE_BUILTIN_LEVELS] = {")
+    for n, (_, spawn, foods, _) in enumerate(levels, 1):
+        padded = foods + [(0, 0)] * (MAX_FOODS - len(foods))
+        food_str = ", ".join(f"{{{x}, {y}}}" for x, y in padded)
+        out.append(f"    {{ {{{spawn[0]}, {spawn[1]}}}, {len(foods)}, {{{food_str}}},")
+        out.append(f"      maze_level_{n}_rle, sizeof(maze_level_{n}_rle) }},")
+    out.append("};")
+    out.append("")
+    out.append("#endif // MAZE_LEVELS_DATA_H")
+    out.append("")
+
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+
+
+def write_bin(level, path):
+    _, spawn, foods, grid = level
+    padded = foods + [(0, 0)] * (MAX_FOODS - len(foods))
+    data = bytearray(BIN_MAGIC)
+    data += bytes(spawn)
+    data.append(len(foods))
+    for x, y in padded:
+        data += bytes((x, y))
+    data += rle_encode(grid)
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("arquivos", nargs="*", help="desenhos (padrão: Ferramentas/niveis/nivel_*.txt)")
+    parser.add_argument("--saida", default=os.path.join(ROOT, "Bibliotecas", "maze_levels_data.h"))
+    parser.add_argument("--bin", metavar="DIR", help="grava também os níveis no formato do cartão SD")
+    parser.add_argument("--primeiro", type=int, default=1, help="número do primeiro arquivo .bin")
+    args = parser.parse_args()
+
+    files = args.arquivos or glob.glob(os.path.join(ROOT, "Ferramentas", "niveis", "nivel_*.txt"))
+    files.sort(key=level_number)
+    levels = [parse_level(p) for p in files]
+
+    if not args.arquivos:
+        write_header(levels, args.saida)
+
+    if args.bin:
+        os.makedirs(args.bin, exist_ok=True)
+        for i, level in enumerate(levels):
+            write_bin(level, os.path.join(args.bin, f"nivel_{args.primeiro + i:02d}.bin"))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,50 @@
+// Benchmark dos jogos no host: mesma rotina do firmware com BENCHMARK_MODE,
+// com entrada sintética ou tirada de um roteiro do simulador. Com arquivos
+// de partida (.rpl gravados pelo firmware ou pelo simulador), só repete as
+// partidas e sai com erro se alguma não terminar igual à gravação.
+//
+//   bench [-n ticks] [-r roteiro] [partida.rpl ...]
+//
+// Compilação: veja Simulador/README.md
+
+#define BENCHMARK_MODE 1
+#include "../Bibliotecas/main.c"
+
+#include <stdio.h>
+#include <unistd.h>
+#include "hal_host.h"
+
+// Amostra o roteiro no período de tick do Snake (o filtro fica com o benchmark)
+static void script_input(int tick, int16_t accel[3]) {
+    hal_host_script_accel_at((int64_t)tick * SNAKE_TICK_MS * 1000, accel);
+}
+
+int main(int argc, char **argv) {
+    int ticks = BENCHMARK_TICKS;
+    BenchInputFn input = benchmark_synthetic_input;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        switch (opt) {
+            case 'n': ticks = atoi(optarg); break;
+            case 'r':
+                if (!hal_host_load_script(optarg)) {
+                    fprintf(stderr, "roteiro invalido: %s\n", optarg);
+                    return 2;
+                }
+                input = script_input;
+                break;
+            default:
+                fprintf(stderr, "uso: %s [-n ticks] [-r roteiro] [partida.rpl ...]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    i2c_master_init();
+    ssd1306_init();
+    if (optind < argc) {
+        return run_replay_benchmarks((const char *const *)&argv[optind], argc - optind) ? 1 : 0;
+    }
+    run_game_benchmarks(ticks, input);
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Mede quantos bytes cada jogo coloca no barramento I2C por quadro, com e sem
+// o rastreamento de áreas alteradas do display.
+//
+// Compilação: veja Simulador/README.md
+
+#include "../Bibliotecas/main.c"
+
+#include <stdio.h>
+#include "i2c_host.h"
+
+#define FRAMES 500
+
+static int mismatches = 0;
+
+// Confere se a RAM simulada do SSD1306 ficou igual ao buffer desenhado
+static void check_panel(void) {
+    if (memcmp(i2c_host_oled_ram(), display_buffer, BUFFER_SIZE) != 0) {
+        mismatches++;
+    }
+}
+
+static void run_snake(void) {
+    SnakeGame game;
+    snake_game_init(&game, 1234);
+    for (int f = 0; f < FRAMES; f++) {
+        if (game.game_over) snake_game_init(&game, 1234);
+        // Anda em quadrado para sobreviver mais tempo
+        if (f % 6 == 0) game.direction = (game.direction + 1) % 4;
+        snake_game_update(&game);
+        game_render(&games[GAME_SNAKE], &game);
+        check_panel();
+    }
+}
+
+static void run_pong(void) {
+    PongGame game;
+    pong_game_init(&game);
+    for (int f = 0; f < FRAMES; f++) {
+        if (game.game_over) pong_game_init(&game);
+        game.paddle_pos = FX_TO_INT(game.ball.x);
+        pong_game_update(&game);
+        game_render(&games[GAME_PONG], &game);
+        check_panel();
+    }
+}
+
+static void run_dodge(void) {
+    DodgeGame game;
+    dodge_game_init(&game, 1234);
+    for (int f = 0; f < FRAMES; f++) {
+        if (game.game_over) dodge_game_init(&game, 1234);
+        game.player.x = (WIDTH - 10) / 2 + (int)(40 * sinf(f * 0.1f));
+        dodge_game_update(&game);
+        game_render(&games[GAME_DODGE], &game);
+        check_panel();
+    }
+}
+
+static void run_tilt_maze(void) {
+    TiltMazeGame game;
+    tilt_maze_init(&game);
+    for (int f = 0; f < FRAMES; f++) {
+        int phase = (f / 20) % 4;
+        game.dx = (phase == 0) - (phase == 2);
+        game.dy = (phase == 1) - (phase == 3);
+        tilt_maze_update(&game);
+        game_render(&games[GAME_TILT_MAZE], &game);
+        check_panel();
+        if (game.level_complete) tilt_maze_init_level(&game, game.level % maze_level_count() + 1);
+    }
+}
+
+static void measure(const char *name, void (*run)(void)) {
+    uint32_t bytes[2];
+    for (int mode = 0; mode < 2; mode++) {
+        display_set_damage_tracking(mode == 1);
+        display_invalidate();
+        i2c_host_reset_stats();
+        run();
+        I2cHostStats s;
+        i2c_host_get_stats(&s);
+        bytes[mode] = s.bytes;
+    }
+    printf("%-10s %10.1f %10.1f %9.1f%%\n", name,
+           bytes[0] / (double)FRAMES, bytes[1] / (double)FRAMES,
+           100.0 * (1.0 - bytes[1] / (double)bytes[0]));
+}
+
+int main(void) {
+    i2c_master_init();
+    ssd1306_init();
+
+    printf("%-10s %10s %10s %10s\n", "jogo", "cheio B/q", "parcial B/q", "reducao");
+    measure("snake", run_snake);
+    measure("pong", run_pong);
+    measure("dodge", run_dodge);
+    measure("tilt_maze", run_tilt_maze);
+
+    if (mismatches) {
+        printf("ERRO: %d quadros com RAM do display diferente do buffer\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,639 @@
+#include "hal_host.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+#include <esp_timer.h>
+#include <esp_random.h>
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+#include <driver/ledc.h>
+
+#include "mpu6050.h"
+#include "sdcard.h"
+#include "maze_levels.h"
+#include "sensor.h"
+#include "scores.h"
+#include "replay.h"
+
+// Relógio virtual em microssegundos: esperas avançam o tempo na hora
+static int64_t now_us = 0;
+static int16_t accel[3] = { 0, 0, 16384 };
+
+typedef struct {
+    int64_t at_us;
+    int16_t accel[3];
+    bool select;
+    bool navigate;
+} ScriptStep;
+
+static ScriptStep *script = NULL;
+static size_t script_len = 0;
+
+static char sdcard_dir[256] = "";
+
+sdmmc_card_t *card = NULL;
+bool sd_card_initialized = false;
+
+// FreeRTOS: o tempo só avança quando alguém espera. Quem conduz o relógio
+// (a thread do app_main e as tarefas abaixo) avança o tempo no vTaskDelay()
+// e espera filas em tempo virtual; as tarefas de fundo esperam semáforos e
+// filas em tempo real, sem mexer no relógio.
+static const char *const clock_tasks[] = { "game_system", "benchmark" };
+static __thread bool drives_clock = false;
+
+static void raise_interrupts(void);
+static int64_t script_next_edge(int64_t after_us);
+
+void vTaskDelay(TickType_t ticks) {
+    int64_t target = esp_timer_get_time() + (int64_t)ticks * portTICK_PERIOD_MS * 1000;
+    int64_t edge;
+
+    // Para em cada troca dos botões do roteiro, para que a interrupção veja
+    // o nível e o instante certos mesmo dentro de uma espera longa
+    while ((edge = script_next_edge(esp_timer_get_time())) > 0 && edge < target) {
+        __atomic_store_n(&now_us, edge, __ATOMIC_SEQ_CST);
+        raise_interrupts();
+    }
+    __atomic_store_n(&now_us, target, __ATOMIC_SEQ_CST);
+    raise_interrupts();
+}
+
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t increment) {
+    TickType_t wake = *previous_wake + increment;
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(wake - now) > 0) vTaskDelay(wake - now);
+    *previous_wake = wake;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(esp_timer_get_time() / (portTICK_PERIOD_MS * 1000));
+}
+
+int64_t esp_timer_get_time(void) {
+    return __atomic_load_n(&now_us, __ATOMIC_SEQ_CST);
+}
+
+// splitmix32 sobre um contador: mesma sequência em toda execução
+uint32_t esp_random(void) {
+    static uint32_t counter = 0;
+    uint32_t z = __atomic_add_fetch(&counter, 0x9E3779B9u, __ATOMIC_SEQ_CST);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+// Cada tarefa vira uma thread; núcleo e prioridade são ignorados
+typedef struct {
+    TaskFunction_t fn;
+    void *arg;
+    bool drives_clock;
+    uint32_t stack;
+} TaskStart;
+
+static __thread uint32_t task_stack = 0;
+
+static void *task_trampoline(void *p) {
+    TaskStart start = *(TaskStart *)p;
+    free(p);
+    drives_clock = start.drives_clock;
+    task_stack = start.stack;
+    start.fn(start.arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *handle, BaseType_t core) {
+    (void)prio; (void)core;
+    TaskStart *start = malloc(sizeof(TaskStart));
+    start->fn = fn;
+    start->arg = arg;
+    start->stack = stack;
+    start->drives_clock = false;
+    for (size_t i = 0; i < sizeof(clock_tasks) / sizeof(clock_tasks[0]); i++) {
+        if (strcmp(name, clock_tasks[i]) == 0) start->drives_clock = true;
+    }
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, task_trampoline, start) != 0) {
+        free(start);
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+    if (handle) *handle = (TaskHandle_t)(uintptr_t)thread;
+    return pdPASS;
+}
+
+// A pilha de uma thread do host não diz nada sobre a do ESP32: sem medição,
+// devolve o tamanho pedido na criação (só a própria tarefa, handle NULL)
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+    (void)task;
+    return task_stack;
+}
+
+// Só a autoexclusão (vTaskDelete(NULL)) é suportada
+void vTaskDelete(TaskHandle_t task) {
+    if (task == NULL) pthread_exit(NULL);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg,
+                       UBaseType_t prio, TaskHandle_t *handle) {
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, 0);
+}
+
+// Semáforos binários e mutexes sobre mutex + variável de condição
+struct host_semaphore {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int count;
+};
+
+static SemaphoreHandle_t semaphore_create(int initial) {
+    SemaphoreHandle_t sem = malloc(sizeof(*sem));
+    pthread_mutex_init(&sem->lock, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    sem->count = initial;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return semaphore_create(0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return semaphore_create(1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    if (ticks_to_wait != portMAX_DELAY) {
+        uint64_t ns = deadline.tv_nsec + (uint64_t)ticks_to_wait * portTICK_PERIOD_MS * 1000000ull;
+        deadline.tv_sec += ns / 1000000000ull;
+        deadline.tv_nsec = ns % 1000000000ull;
+    }
+
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0) {
+        if (ticks_to_wait == portMAX_DELAY) {
+            pthread_cond_wait(&sem->cond, &sem->lock);
+        } else if (ticks_to_wait == 0 ||
+                   pthread_cond_timedwait(&sem->cond, &sem->lock, &deadline) != 0) {
+            pthread_mutex_unlock(&sem->lock);
+            return pdFALSE;
+        }
+    }
+    sem->count = 0;
+    pthread_mutex_unlock(&sem->lock);
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *higher_priority_task_woken) {
+    if (higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xSemaphoreGive(sem);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    pthread_mutex_lock(&sem->lock);
+    sem->count = 1;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->lock);
+    return pdTRUE;
+}
+
+// Filas: buffer circular de itens copiados, mesma espera dos semáforos (em
+// tempo real: não avança o relógio virtual)
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    uint8_t *items;
+    UBaseType_t length, item_size;
+    UBaseType_t head, count;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    QueueHandle_t queue = calloc(1, sizeof(*queue));
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->changed, NULL);
+    queue->items = malloc(length * item_size);
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+// Espera até ready() valer ou o prazo acabar; chamada com o lock
+static bool queue_wait(QueueHandle_t queue, bool (*ready)(QueueHandle_t), TickType_t ticks_to_wait) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    if (ticks_to_wait != portMAX_DELAY) {
+        uint64_t ns = deadline.tv_nsec + (uint64_t)ticks_to_wait * portTICK_PERIOD_MS * 1000000ull;
+        deadline.tv_sec += ns / 1000000000ull;
+        deadline.tv_nsec = ns % 1000000000ull;
+    }
+    while (!ready(queue)) {
+        if (ticks_to_wait == portMAX_DELAY) {
+            pthread_cond_wait(&queue->changed, &queue->lock);
+        } else if (ticks_to_wait == 0 ||
+                   pthread_cond_timedwait(&queue->changed, &queue->lock, &deadline) != 0) {
+            return ready(queue);
+        }
+    }
+    return true;
+}
+
+static bool queue_has_space(QueueHandle_t queue) { return queue->count < queue->length; }
+static bool queue_has_items(QueueHandle_t queue) { return queue->count > 0; }
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait) {
+    pthread_mutex_lock(&queue->lock);
+    if (!queue_wait(queue, queue_has_space, ticks_to_wait)) {
+        pthread_mutex_unlock(&queue->lock);
+        return pdFALSE;
+    }
+    UBaseType_t slot = (queue->head + queue->count) % queue->length;
+    memcpy(queue->items + slot * queue->item_size, item, queue->item_size);
+    queue->count++;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks_to_wait) {
+    // Quem conduz o relógio espera em tempo virtual: cada tick pode trazer
+    // uma interrupção do roteiro que alimenta a fila
+    if (drives_clock && ticks_to_wait > 0) {
+        for (TickType_t waited = 0; ; waited++) {
+            if (xQueueReceive(queue, item, 0)) return pdTRUE;
+            if (ticks_to_wait != portMAX_DELAY && waited >= ticks_to_wait) return pdFALSE;
+            vTaskDelay(1);
+        }
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    if (!queue_wait(queue, queue_has_items, ticks_to_wait)) {
+        pthread_mutex_unlock(&queue->lock);
+        return pdFALSE;
+    }
+    memcpy(item, queue->items + queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+    return pdTRUE;
+}
+
+// Interrupções do host rodam na thread que avançou o relógio: nunca bloqueia
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken) {
+    if (higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    pthread_mutex_lock(&queue->lock);
+    queue->head = 0;
+    queue->count = 0;
+    pthread_cond_broadcast(&queue->changed);
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t spaces = queue->length - queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return spaces;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio, gpio_mode_t mode) { (void)gpio; (void)mode; return ESP_OK; }
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio, gpio_pull_mode_t pull) { (void)gpio; (void)pull; return ESP_OK; }
+esp_err_t gpio_set_intr_type(gpio_num_t gpio, gpio_int_type_t type) { (void)gpio; (void)type; return ESP_OK; }
+esp_err_t gpio_install_isr_service(int flags) { (void)flags; return ESP_OK; }
+
+typedef struct {
+    gpio_isr_t handler;
+    void *arg;
+} IsrSlot;
+
+static IsrSlot isr_slots[GPIO_NUM_MAX];
+static bool intr_disabled[GPIO_NUM_MAX];
+static gpio_int_type_t wakeup_levels[GPIO_NUM_MAX];
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t handler, void *arg) {
+    isr_slots[gpio] = (IsrSlot){ handler, arg };
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio) {
+    isr_slots[gpio] = (IsrSlot){ NULL, NULL };
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio) { intr_disabled[gpio] = false; return ESP_OK; }
+esp_err_t gpio_intr_disable(gpio_num_t gpio) { intr_disabled[gpio] = true; return ESP_OK; }
+
+esp_err_t gpio_wakeup_enable(gpio_num_t gpio, gpio_int_type_t type) {
+    if (type != GPIO_INTR_LOW_LEVEL && type != GPIO_INTR_HIGH_LEVEL) return ESP_ERR_INVALID_ARG;
+    wakeup_levels[gpio] = type;
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t gpio) { wakeup_levels[gpio] = GPIO_INTR_DISABLE; return ESP_OK; }
+
+// Passo do roteiro em vigor no instante dado (NULL sem roteiro)
+static const ScriptStep *script_at(int64_t at_us) {
+    if (script_len == 0) return NULL;
+    size_t i = 0;
+    while (i + 1 < script_len && script[i + 1].at_us <= at_us) i++;
+    return &script[i];
+}
+
+static const ScriptStep *script_now(void) {
+    return script_at(esp_timer_get_time());
+}
+
+// Instante da próxima troca de botões do roteiro depois de after_us (0 se
+// não houver)
+static int64_t script_next_edge(int64_t after_us) {
+    for (size_t i = 1; i < script_len; i++) {
+        if (script[i].at_us <= after_us) continue;
+        if (script[i].select != script[i - 1].select ||
+            script[i].navigate != script[i - 1].navigate) {
+            return script[i].at_us;
+        }
+    }
+    return 0;
+}
+
+int gpio_get_level(gpio_num_t gpio) {
+    const ScriptStep *step = script_now();
+    if (step == NULL) return 0;
+    if (gpio == GPIO_NUM_27) return step->select;
+    if (gpio == GPIO_NUM_4) return step->navigate;
+    return 0;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *conf) { (void)conf; return ESP_OK; }
+esp_err_t ledc_channel_config(const ledc_channel_config_t *conf) { (void)conf; return ESP_OK; }
+esp_err_t ledc_set_freq(ledc_mode_t mode, ledc_timer_t timer, uint32_t freq_hz) { (void)mode; (void)timer; (void)freq_hz; return ESP_OK; }
+esp_err_t ledc_set_duty(ledc_mode_t mode, ledc_channel_t channel, uint32_t duty) { (void)mode; (void)channel; (void)duty; return ESP_OK; }
+esp_err_t ledc_update_duty(ledc_mode_t mode, ledc_channel_t channel) { (void)mode; (void)channel; return ESP_OK; }
+
+void mpu6050_init() {}
+
+bool mpu6050_set_sleep(bool sleep) { (void)sleep; return true; }
+
+void mpu6050_read_accel(int16_t *ax, int16_t *ay, int16_t *az) {
+    const ScriptStep *step = script_now();
+    const int16_t *src = step ? step->accel : accel;
+    *ax = src[0];
+    *ay = src[1];
+    *az = src[2];
+}
+
+bool mpu6050_read_accel_locked(int16_t *ax, int16_t *ay, int16_t *az) {
+    mpu6050_read_accel(ax, ay, az);
+    return true;
+}
+
+// FIFO simulado: amostras na taxa configurada seguindo o relógio virtual,
+// cada uma com a aceleração do roteiro no seu instante; giroscópio parado.
+// Com a interrupção de dado pronto ligada, cada vTaskDelay() que passa por
+// uma amostra nova dispara o handler do pino INT.
+static pthread_mutex_t fifo_lock = PTHREAD_MUTEX_INITIALIZER;
+static int64_t fifo_period_us = 0;
+static int64_t fifo_next_us = 0;
+static bool data_ready_int = false;
+
+bool mpu6050_fifo_start(int sample_rate_hz) {
+    if (sample_rate_hz < 4 || sample_rate_hz > 1000) return false;
+    pthread_mutex_lock(&fifo_lock);
+    fifo_period_us = 1000000 / sample_rate_hz;
+    fifo_next_us = esp_timer_get_time() + fifo_period_us;
+    pthread_mutex_unlock(&fifo_lock);
+    return true;
+}
+
+void mpu6050_fifo_stop() {
+    pthread_mutex_lock(&fifo_lock);
+    fifo_period_us = 0;
+    pthread_mutex_unlock(&fifo_lock);
+}
+
+void mpu6050_fifo_reset() {
+    pthread_mutex_lock(&fifo_lock);
+    fifo_next_us = esp_timer_get_time() + fifo_period_us;
+    pthread_mutex_unlock(&fifo_lock);
+}
+
+bool mpu6050_enable_data_ready_int() {
+    data_ready_int = true;
+    return true;
+}
+
+int mpu6050_fifo_read(Mpu6050Sample *samples, int max_samples) {
+    int64_t now = esp_timer_get_time();
+    int n = 0;
+
+    pthread_mutex_lock(&fifo_lock);
+    if (fifo_period_us == 0) {
+        pthread_mutex_unlock(&fifo_lock);
+        return 0;
+    }
+
+    // Mais amostras do que cabem no FIFO: transbordou, como no sensor
+    if ((now - fifo_next_us) / fifo_period_us >= MPU6050_FIFO_SIZE / MPU6050_FIFO_SAMPLE_BYTES) {
+        fifo_next_us = now + fifo_period_us;
+        pthread_mutex_unlock(&fifo_lock);
+        return 0;
+    }
+    while (n < max_samples && n < MPU6050_FIFO_MAX_BATCH && fifo_next_us <= now) {
+        int16_t a[3];
+        hal_host_script_accel_at(fifo_next_us, a);
+        samples[n] = (Mpu6050Sample){ a[0], a[1], a[2], 0, 0, 0 };
+        fifo_next_us += fifo_period_us;
+        n++;
+    }
+    pthread_mutex_unlock(&fifo_lock);
+    return n;
+}
+
+static bool fifo_has_data(void) {
+    pthread_mutex_lock(&fifo_lock);
+    bool ready = fifo_period_us != 0 && fifo_next_us <= esp_timer_get_time();
+    pthread_mutex_unlock(&fifo_lock);
+    return ready;
+}
+
+// Nível dos botões na última verificação, para detectar as bordas
+static int button_levels[GPIO_NUM_MAX];
+
+static void raise_button_edge(gpio_num_t pin) {
+    int level = gpio_get_level(pin);
+    if (level == button_levels[pin]) return;
+    button_levels[pin] = level;
+    if (isr_slots[pin].handler && !intr_disabled[pin]) isr_slots[pin].handler(isr_slots[pin].arg);
+}
+
+static bool gpio_wakeup_pending(void) {
+    for (int pin = 0; pin < GPIO_NUM_MAX; pin++) {
+        if (wakeup_levels[pin] == GPIO_INTR_DISABLE) continue;
+        if (gpio_get_level(pin) == (wakeup_levels[pin] == GPIO_INTR_HIGH_LEVEL)) return true;
+    }
+    return false;
+}
+
+// Light sleep: o relógio virtual anda até um pino de despertar chegar ao
+// nível; como no chip, um pino já no nível faz voltar na hora
+static bool gpio_wakeup_armed = false;
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void) {
+    gpio_wakeup_armed = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_light_sleep_start(void) {
+    if (!gpio_wakeup_armed) return ESP_ERR_INVALID_STATE;
+    while (!gpio_wakeup_pending()) {
+        vTaskDelay(1);
+    }
+    return ESP_OK;
+}
+
+// "Interrupções" pendentes depois que o relógio andou
+static void raise_interrupts(void) {
+    IsrSlot slot = isr_slots[MPU6050_INT_PIN];
+    if (data_ready_int && slot.handler && fifo_has_data()) {
+        slot.handler(slot.arg);
+    }
+    raise_button_edge(GPIO_NUM_27);
+    raise_button_edge(GPIO_NUM_4);
+}
+
+float low_pass_filter(float new_value, float old_value, float alpha) {
+    return alpha * new_value + (1.0f - alpha) * old_value;
+}
+
+void hal_host_set_accel(int16_t ax, int16_t ay, int16_t az) {
+    accel[0] = ax;
+    accel[1] = ay;
+    accel[2] = az;
+}
+
+bool hal_host_load_script(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return false;
+
+    char line[128];
+    size_t capacity = 0;
+    while (fgets(line, sizeof(line), f)) {
+        ScriptStep step = { 0 };
+        long at_ms;
+        int ax, ay, az;
+        char buttons[8] = "-";
+        if (line[0] == '#' || sscanf(line, "%ld %d %d %d %7s", &at_ms, &ax, &ay, &az, buttons) < 4) {
+            continue;
+        }
+        step.at_us = (int64_t)at_ms * 1000;
+        step.accel[0] = ax;
+        step.accel[1] = ay;
+        step.accel[2] = az;
+        step.select = strchr(buttons, 'S') != NULL;
+        step.navigate = strchr(buttons, 'N') != NULL;
+
+        if (script_len == capacity) {
+            capacity = capacity ? capacity * 2 : 16;
+            script = realloc(script, capacity * sizeof(ScriptStep));
+        }
+        script[script_len++] = step;
+    }
+    fclose(f);
+    return script_len > 0;
+}
+
+void hal_host_script_accel_at(int64_t at_us, int16_t out[3]) {
+    const ScriptStep *step = script_at(at_us);
+    const int16_t *src = step ? step->accel : accel;
+    out[0] = src[0];
+    out[1] = src[1];
+    out[2] = src[2];
+}
+
+int64_t hal_host_script_end_us(void) {
+    return script_len ? script[script_len - 1].at_us : 0;
+}
+
+void hal_host_set_sdcard_dir(const char *dir) {
+    snprintf(sdcard_dir, sizeof(sdcard_dir), "%s", dir);
+}
+
+const char *hal_host_sdcard_dir(void) {
+    return sdcard_dir;
+}
+
+// Cartão SD no diretório simulado: recordes em <dir>/scores.bin e
+// <dir>/scores.log (o formato antigo, um arquivo texto por jogo, só é lido
+// na importação), níveis extras do Tilt Maze em <dir>/niveis, calibração
+// em <dir>/calib.txt e a última partida de cada jogo em <dir>/replays
+bool init_sd_card() {
+    char levels[300];
+    char calib[300];
+    char replays[300];
+
+    if (sdcard_dir[0] == '\0') {
+        char tmpl[] = "/tmp/sim_sdcard_XXXXXX";
+        if (mkdtemp(tmpl) == NULL) return false;
+        hal_host_set_sdcard_dir(tmpl);
+    }
+    mkdir(sdcard_dir, 0755);
+    snprintf(levels, sizeof(levels), "%s/niveis", sdcard_dir);
+    maze_level_set_dir(levels);
+    snprintf(calib, sizeof(calib), "%s/calib.txt", sdcard_dir);
+    sensor_set_calibration_path(calib);
+    scores_set_dir(sdcard_dir);
+    snprintf(replays, sizeof(replays), "%s/replays", sdcard_dir);
+    replay_set_dir(replays);
+    return true;
+}
+
+static void score_path(char *path, size_t size, const char *game_name) {
+    snprintf(path, size, "%s/%s.txt", sdcard_dir, game_name);
+}
+
+int read_high_score(const char *game_name) {
+    if (!sd_card_initialized) return 0;
+
+    char path[300];
+    score_path(path, sizeof(path), game_name);
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return 0;
+
+    int score = 0;
+    if (fscanf(f, "%d", &score) != 1) score = 0;
+    fclose(f);
+    return score;
+}
+
+void write_high_score(const char *game_name, int score) {
+    if (!sd_card_initialized) return;
+
+    char path[300];
+    score_path(path, sizeof(path), game_name);
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return;
+    fprintf(f, "%d\n", score);
+    fclose(f);
+}
@@ -0,0 +1,22 @@
+// Implementações substitutas do HAL para o build no host
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Próxima leitura de mpu6050_read_accel() devolve estes valores
+void hal_host_set_accel(int16_t ax, int16_t ay, int16_t az);
+
+// Roteiro de entrada: cada linha "tempo_ms ax ay az botoes" vale até a
+// próxima; botoes é "-", "S" (SELECT), "N" (NAVIGATE) ou "SN".
+// Linhas vazias e iniciadas por '#' são ignoradas.
+bool hal_host_load_script(const char *path);
+int64_t hal_host_script_end_us(void);
+void hal_host_script_accel_at(int64_t at_us, int16_t accel[3]);
+
+// Diretório que faz o papel de /sdcard (criado em /tmp se não informado)
+void hal_host_set_sdcard_dir(const char *dir);
+const char *hal_host_sdcard_dir(void);
+
+#endif // HAL_HOST_H
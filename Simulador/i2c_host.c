@@ -0,0 +1,220 @@
+#include "i2c_host.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <driver/i2c.h>
+
+#define OLED_ADDR 0x3C
+#define OLED_WIDTH 128
+#define OLED_PAGES 8
+
+typedef enum { OP_START, OP_WRITE, OP_READ, OP_STOP } OpKind;
+
+typedef struct {
+    OpKind kind;
+    uint8_t value;        // OP_WRITE de um byte
+    const uint8_t *data;  // OP_WRITE de bloco (lido só no cmd_begin, como no IDF)
+    uint8_t *dest;        // OP_READ
+    size_t len;
+} Op;
+
+struct i2c_host_cmd {
+    Op *ops;
+    size_t count;
+    size_t capacity;
+};
+
+static I2cHostStats stats;
+static uint32_t bus_clock_hz = 0;
+static I2cHostOledHook oled_hook = NULL;
+
+// Estado do SSD1306 simulado
+static uint8_t oled_ram[OLED_WIDTH * OLED_PAGES];
+static int oled_col0 = 0, oled_col1 = OLED_WIDTH - 1;
+static int oled_page0 = 0, oled_page1 = OLED_PAGES - 1;
+static int oled_col = 0, oled_page = 0;
+static uint8_t oled_pending_cmd = 0;
+static int oled_args_needed = 0;
+static uint8_t oled_args[2];
+static int oled_arg_count = 0;
+static bool oled_on = false;   // o SSD1306 liga com o painel apagado
+
+static void push(i2c_cmd_handle_t cmd, Op op) {
+    if (cmd->count == cmd->capacity) {
+        cmd->capacity = cmd->capacity ? cmd->capacity * 2 : 32;
+        cmd->ops = realloc(cmd->ops, cmd->capacity * sizeof(Op));
+    }
+    cmd->ops[cmd->count++] = op;
+}
+
+esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t *conf) {
+    (void)port; (void)conf;
+    return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t rx_buf, size_t tx_buf, int flags) {
+    (void)port; (void)mode; (void)rx_buf; (void)tx_buf; (void)flags;
+    return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void) {
+    return calloc(1, sizeof(struct i2c_host_cmd));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd) {
+    if (cmd == NULL) return;
+    free(cmd->ops);
+    free(cmd);
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd) {
+    push(cmd, (Op){ .kind = OP_START });
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd) {
+    push(cmd, (Op){ .kind = OP_STOP });
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en) {
+    (void)ack_en;
+    push(cmd, (Op){ .kind = OP_WRITE, .value = data, .len = 1 });
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t *data, size_t len, bool ack_en) {
+    (void)ack_en;
+    push(cmd, (Op){ .kind = OP_WRITE, .data = data, .len = len });
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd, uint8_t *data, i2c_ack_type_t ack) {
+    (void)ack;
+    push(cmd, (Op){ .kind = OP_READ, .dest = data, .len = 1 });
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t *data, size_t len, i2c_ack_type_t ack) {
+    (void)ack;
+    push(cmd, (Op){ .kind = OP_READ, .dest = data, .len = len });
+    return ESP_OK;
+}
+
+static void oled_command(uint8_t c) {
+    if (oled_args_needed > 0) {
+        oled_args[oled_arg_count++] = c;
+        if (--oled_args_needed > 0) return;
+
+        if (oled_pending_cmd == 0x21) {
+            oled_col0 = oled_args[0] & 0x7F;
+            oled_col1 = oled_args[1] & 0x7F;
+            oled_col = oled_col0;
+        } else if (oled_pending_cmd == 0x22) {
+            oled_page0 = oled_args[0] & 0x07;
+            oled_page1 = oled_args[1] & 0x07;
+            oled_page = oled_page0;
+        }
+        return;
+    }
+
+    oled_pending_cmd = c;
+    oled_arg_count = 0;
+    if (c == 0xAE || c == 0xAF) oled_on = c == 0xAF;
+    switch (c) {
+        case 0x21: case 0x22: oled_args_needed = 2; break;
+        case 0x20: case 0x8D: case 0x81: case 0xA8: case 0xD3: case 0xD5:
+        case 0xD9: case 0xDA: case 0xDB: oled_args_needed = 1; break;
+        default: oled_args_needed = 0; break;
+    }
+}
+
+// Endereçamento horizontal: avança coluna e quebra de página dentro da janela
+static void oled_data(uint8_t d) {
+    oled_ram[oled_page * OLED_WIDTH + oled_col] = d;
+    if (++oled_col > oled_col1) {
+        oled_col = oled_col0;
+        if (++oled_page > oled_page1) oled_page = oled_page0;
+    }
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks_to_wait) {
+    (void)port; (void)ticks_to_wait;
+    stats.transactions++;
+
+    int addr = -1;
+    bool first_byte = false;
+    bool oled_data_mode = false;
+    bool oled_written = false;
+    uint32_t bytes_before = stats.bytes;
+
+    for (size_t i = 0; i < cmd->count; i++) {
+        Op *op = &cmd->ops[i];
+        switch (op->kind) {
+            case OP_START:
+                addr = -1;
+                break;
+            case OP_STOP:
+                break;
+            case OP_READ:
+                stats.bytes += op->len;
+                memset(op->dest, 0, op->len);
+                break;
+            case OP_WRITE:
+                stats.bytes += op->len;
+                for (size_t k = 0; k < op->len; k++) {
+                    uint8_t b = op->data ? op->data[k] : op->value;
+                    if (addr < 0) {
+                        addr = b >> 1;
+                        first_byte = true;
+                    } else if (addr == OLED_ADDR) {
+                        if (first_byte) {
+                            oled_data_mode = (b & 0x40) != 0;
+                            first_byte = false;
+                        } else if (oled_data_mode) {
+                            oled_data(b);
+                            oled_written = true;
+                        } else {
+                            bool was_on = oled_on;
+                            oled_command(b);
+                            oled_written |= oled_on != was_on;
+                        }
+                    }
+                }
+                break;
+        }
+    }
+
+    if (bus_clock_hz > 0) {
+        uint64_t ns = (uint64_t)(stats.bytes - bytes_before) * 9 * 1000000000ull / bus_clock_hz;
+        struct timespec t = { (time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull) };
+        nanosleep(&t, NULL);
+    }
+    if (oled_written && oled_hook) oled_hook(oled_ram);
+    return ESP_OK;
+}
+
+bool i2c_host_oled_on(void) {
+    return oled_on;
+}
+
+void i2c_host_set_bus_clock(uint32_t hz) {
+    bus_clock_hz = hz;
+}
+
+void i2c_host_get_stats(I2cHostStats *out) {
+    *out = stats;
+}
+
+void i2c_host_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+const uint8_t *i2c_host_oled_ram(void) {
+    return oled_ram;
+}
+
+void i2c_host_set_oled_hook(I2cHostOledHook hook) {
+    oled_hook = hook;
+}
@@ -0,0 +1,32 @@
+// Barramento I2C simulado do build no host: conta o tráfego e mantém um
+// modelo da RAM do SSD1306 para conferir o que foi realmente enviado
+#ifndef I2C_HOST_H
+#define I2C_HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t transactions;  // chamadas de i2c_master_cmd_begin
+    uint32_t bytes;         // bytes no fio (endereços + dados)
+} I2cHostStats;
+
+void i2c_host_get_stats(I2cHostStats *stats);
+void i2c_host_reset_stats(void);
+
+// Simula a duração real das transações (9 bits por byte no clock dado);
+// 0 desliga a espera
+void i2c_host_set_bus_clock(uint32_t hz);
+
+// RAM do SSD1306 simulada, no mesmo layout de display_buffer
+const uint8_t *i2c_host_oled_ram(void);
+
+// Painel ligado (0xAF) ou apagado (0xAE); a RAM é mantida nos dois casos
+bool i2c_host_oled_on(void);
+
+// Chamado (na tarefa que fez a transação) sempre que a RAM do SSD1306 muda
+// ou o painel liga/apaga
+typedef void (*I2cHostOledHook)(const uint8_t *ram);
+void i2c_host_set_oled_hook(I2cHostOledHook hook);
+
+#endif // I2C_HOST_H
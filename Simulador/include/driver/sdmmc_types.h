@@ -0,0 +1,9 @@
+// Substituto do driver/sdmmc_types.h do ESP-IDF para o build no host
+#ifndef HOST_DRIVER_SDMMC_TYPES_H
+#define HOST_DRIVER_SDMMC_TYPES_H
+
+typedef struct {
+    int dummy;
+} sdmmc_card_t;
+
+#endif // HOST_DRIVER_SDMMC_TYPES_H
@@ -0,0 +1,7 @@
+// Substituto do esp_attr.h do ESP-IDF para o build no host
+#ifndef HOST_ESP_ATTR_H
+#define HOST_ESP_ATTR_H
+
+#define IRAM_ATTR
+
+#endif // HOST_ESP_ATTR_H
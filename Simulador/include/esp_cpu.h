@@ -0,0 +1,15 @@
+// Substituto do esp_cpu.h do ESP-IDF para o build no host: o "contador de
+// ciclos" conta nanossegundos reais (veja sdkconfig.h, CPU de 1000 MHz)
+#ifndef HOST_ESP_CPU_H
+#define HOST_ESP_CPU_H
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint32_t esp_cpu_get_cycle_count(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)((uint64_t)t.tv_sec * 1000000000ull + t.tv_nsec);
+}
+
+#endif // HOST_ESP_CPU_H
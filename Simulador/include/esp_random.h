@@ -0,0 +1,10 @@
+// Substituto do esp_random.h do ESP-IDF para o build no host
+#ifndef HOST_ESP_RANDOM_H
+#define HOST_ESP_RANDOM_H
+
+#include <stdint.h>
+
+// Sequência fixa por execução, para o simulador ser reproduzível
+uint32_t esp_random(void);
+
+#endif // HOST_ESP_RANDOM_H
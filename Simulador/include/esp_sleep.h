@@ -0,0 +1,13 @@
+// Substituto do esp_sleep.h do ESP-IDF para o build no host
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+
+#include "esp_err.h"
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void);
+
+// Avança o relógio virtual até um pino armado com gpio_wakeup_enable()
+// chegar ao nível
+esp_err_t esp_light_sleep_start(void);
+
+#endif // HOST_ESP_SLEEP_H
@@ -0,0 +1,9 @@
+// Substituto do esp_timer.h do ESP-IDF para o build no host
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif // HOST_ESP_TIMER_H
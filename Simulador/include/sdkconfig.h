@@ -0,0 +1,7 @@
+// Configuração mínima equivalente ao sdkconfig.h gerado pelo ESP-IDF
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 1000
+
+#endif // HOST_SDKCONFIG_H
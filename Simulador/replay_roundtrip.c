@@ -0,0 +1,105 @@
+// Grava partidas sintéticas com replay.c e confere se a leitura devolve a
+// mesma entrada tick a tick: uma partida inteira parada na zona morta (só
+// bytes de repetição, 127 ticks cada, enchendo vários blocos seguidos),
+// trechos longos iguais com trocas e saltos grandes a cada tick. Roda uma
+// vez gravando na hora e outra pela tarefa de gravação.
+//
+// Compilação: veja Simulador/README.md
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+
+// 100000 ticks parados viram ~790 bytes de repetição, mais que REPLAY_CHUNK
+#define TICKS_STILL 100000
+#define TICKS 6000
+
+// Com a tarefa, espera a gravação a cada tantos ticks: no jogo um bloco leva
+// pelo menos 73 ticks para encher, aqui o laço não tem quadro entre eles
+#define TASK_SYNC_TICKS 64
+
+static bool with_task = false;
+
+// Entrada do tick t em cada cenário
+static TiltInput input_still(int t) {
+    (void)t;
+    return (TiltInput){ 0 };
+}
+
+static TiltInput input_runs(int t) {
+    // Trechos de 700 ticks iguais (mais que REPLAY_REPEAT_MAX) com trocas
+    int run = t / 700;
+    return (TiltInput){ (q15_t)(run * 1500 - 6000), (q15_t)(-run * 900), (int8_t)(run % 3 - 1), (int8_t)((run / 3) % 3 - 1) };
+}
+
+static TiltInput input_jumps(int t) {
+    // Diferenças que ocupam o varint inteiro a cada tick
+    q15_t x = (t & 1) ? 32767 : -32768;
+    return (TiltInput){ x, (q15_t)-x, (int8_t)((t & 1) ? 1 : -1), 0 };
+}
+
+static bool same_input(const TiltInput *a, const TiltInput *b) {
+    return a->x == b->x && a->y == b->y && a->dir_x == b->dir_x && a->dir_y == b->dir_y;
+}
+
+static bool roundtrip(const char *dir, const char *name, int ticks, TiltInput (*input)(int)) {
+    static ReplayWriter writer;
+    static ReplayReader reader;
+    char path[256];
+
+    snprintf(path, sizeof(path), "%s/%s.rpl", dir, name);
+    if (!replay_writer_open(&writer, path, 0, 1234, 30)) {
+        printf("%-8s ERRO ao criar %s\n", name, path);
+        return false;
+    }
+    for (int t = 0; t < ticks; t++) {
+        TiltInput in = input(t);
+        replay_writer_tick(&writer, &in);
+        if (with_task && t % TASK_SYNC_TICKS == 0) replay_flush();
+    }
+    if (!replay_writer_close(&writer, 42)) {
+        printf("%-8s ERRO ao fechar\n", name);
+        return false;
+    }
+    replay_flush();
+
+    if (!replay_reader_open(&reader, path)) {
+        printf("%-8s ERRO ao abrir\n", name);
+        return false;
+    }
+    int t = 0;
+    bool ok = reader.header.ticks == (uint32_t)ticks && reader.header.final_score == 42;
+    TiltInput got;
+    while (ok && replay_reader_next(&reader, &got)) {
+        TiltInput want = input(t);
+        if (!same_input(&got, &want)) {
+            printf("%-8s diverge no tick %d\n", name, t);
+            ok = false;
+        }
+        t++;
+    }
+    long size = ftell(reader.file);
+    replay_reader_close(&reader);
+    ok = ok && t == ticks;
+
+    printf("%-8s %-7s %6d ticks %7ld bytes  %s\n", name, with_task ? "tarefa" : "na hora",
+           t, size, ok ? "ok" : "FALHOU");
+    return ok;
+}
+
+int main(void) {
+    char dir[] = "/tmp/replay_roundtrip_XXXXXX";
+    if (mkdtemp(dir) == NULL) return 2;
+    sd_card_initialized = true;
+    replay_set_dir(dir);
+
+    bool ok = true;
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) with_task = replay_start_task(REPLAY_TASK_CORE);
+        ok &= roundtrip(dir, "parado", TICKS_STILL, input_still);
+        ok &= roundtrip(dir, "trechos", TICKS, input_runs);
+        ok &= roundtrip(dir, "saltos", TICKS, input_jumps);
+    }
+    return ok && with_task ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// Simulação do sistema inteiro no host: roda app_main()/game_task de main.c
+// com entrada de roteiro, relógio virtual e cartão SD num diretório local.
+//
+//   sim <roteiro> [-o dir_pbm] [-t] [-s dir_sdcard]
+//
+//   -o  grava cada quadro diferente enviado ao display como PBM
+//   -t  desenha os quadros no terminal
+//   -s  diretório que faz o papel de /sdcard (padrão: /tmp/sim_sdcard_XXXXXX)
+
+#include "../Bibliotecas/main.c"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <esp_timer.h>
+#include "hal_host.h"
+#include "i2c_host.h"
+
+static const char *pbm_dir = NULL;
+static bool terminal = false;
+static uint8_t last_frame[BUFFER_SIZE];
+static int frame_index = 0;
+static bool panel_seen = false, panel_on = false;
+
+static int pixel(const uint8_t *ram, int x, int y) {
+    return (ram[x + (y / 8) * WIDTH] >> (y % 8)) & 1;
+}
+
+static void write_pbm(const uint8_t *ram, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return;
+    fprintf(f, "P1\n%d %d\n", WIDTH, HEIGHT);
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            fputc(pixel(ram, x, y) ? '1' : '0', f);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+}
+
+// Duas linhas de pixels por linha de terminal com meios-blocos
+static void print_frame(const uint8_t *ram) {
+    printf("--- quadro %d (t = %lld ms)\n", frame_index, (long long)(esp_timer_get_time() / 1000));
+    for (int y = 0; y < HEIGHT; y += 2) {
+        for (int x = 0; x < WIDTH; x++) {
+            int top = pixel(ram, x, y);
+            int bottom = pixel(ram, x, y + 1);
+            fputs(top && bottom ? "█" : top ? "▀" : bottom ? "▄" : " ", stdout);
+        }
+        fputc('\n', stdout);
+    }
+}
+
+static void on_frame(const uint8_t *ram) {
+    bool on = i2c_host_oled_on();
+    if (on != panel_on) {
+        if (panel_seen) {
+            fprintf(stderr, "--- tela %s (t = %lld ms)\n", on ? "ligada" : "apagada",
+                    (long long)(esp_timer_get_time() / 1000));
+        }
+        panel_seen = true;
+        panel_on = on;
+    }
+    if (memcmp(ram, last_frame, BUFFER_SIZE) == 0) return;
+    memcpy(last_frame, ram, BUFFER_SIZE);
+
+    if (pbm_dir) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/quadro_%05d.pbm", pbm_dir, frame_index);
+        write_pbm(ram, path);
+    }
+    if (terminal) print_frame(ram);
+    frame_index++;
+}
+
+int main(int argc, char **argv) {
+    const char *script_path = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "o:ts:")) != -1) {
+        switch (opt) {
+            case 'o': pbm_dir = optarg; break;
+            case 't': terminal = true; break;
+            case 's': hal_host_set_sdcard_dir(optarg); break;
+            default:
+                fprintf(stderr, "uso: %s <roteiro> [-o dir_pbm] [-t] [-s dir_sdcard]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (optind < argc) script_path = argv[optind];
+    if (script_path == NULL || !hal_host_load_script(script_path)) {
+        fprintf(stderr, "roteiro invalido: %s\n", script_path ? script_path : "(nenhum)");
+        return 2;
+    }
+
+    i2c_host_set_oled_hook(on_frame);
+    app_main();
+
+    // game_task roda em outra thread; o relógio virtual só anda quando ela espera
+    while (esp_timer_get_time() < hal_host_script_end_us()) {
+        usleep(100);
+    }
+
+    fprintf(stderr, "fim do roteiro: %d quadros, recordes em %s\n", frame_index, hal_host_sdcard_dir());
+    return 0;
+}